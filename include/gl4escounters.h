@@ -0,0 +1,49 @@
+#ifndef _GL4ESINCLUDE_COUNTERS_H_
+#define _GL4ESINCLUDE_COUNTERS_H_
+
+// Internal counters of what gl4es is doing, per frame (a frame ends at each SwapBuffers)
+// Set LIBGL_COUNTERS=N to also print them every N frames
+
+typedef struct {
+    unsigned long long  frames;             // number of frames in the counters
+    unsigned long long  fpe_switches;       // FPE program changed by fpe_program
+    unsigned long long  fpe_misses;         // FPE program not found in cache (new program built)
+    unsigned long long  shader_converts;    // shader sources converted (glShaderSource)
+    unsigned long long  shader_convert_ns;  //  time spent converting them
+    unsigned long long  shader_compiles;    // shaders compiled by the driver
+    unsigned long long  shader_compile_ns;  //  time spent compiling them
+    unsigned long long  program_links;      // programs linked
+    unsigned long long  program_link_ns;    //  time spent linking them (including uniform / attrib enumeration)
+    unsigned long long  uniforms_sent;      // uniform values sent to the driver
+    unsigned long long  uniforms_skipped;   // uniform values skipped because the value was already there
+    unsigned long long  pixel_converts;     // calls to pixel_convert
+    unsigned long long  pixel_convert_bytes;//  bytes written by them
+    unsigned long long  renderlist_flushes; // renderlist drawn by the glBegin/glEnd (and small draws) merger
+    unsigned long long  state_sent;         // state changes (enable, blend, depth, binds...) sent to the driver
+    unsigned long long  state_elided;       // state changes dropped because the driver already had that state
+    unsigned long long  stream_uploads;     // draws with client arrays streamed in the ring VBO
+    unsigned long long  stream_bytes;       //  bytes uploaded for them
+    unsigned long long  stream_orphans;     //  times the ring VBO was full and orphaned
+    unsigned long long  index_scans;        // index lists scanned for their min/max
+    unsigned long long  index_scans_cached; // min/max found in the element buffer cache instead
+    unsigned long long  fpe_ubo_uploads;    // updates of the FPE builtins uniform block
+    unsigned long long  fpe_ubo_bytes;      //  bytes uploaded for them
+    unsigned long long  drawmerge_runs;     // merged draws sent by the client arrays draws merger
+    unsigned long long  drawmerge_draws;    //  glDrawArrays / glDrawElements merged in them
+    unsigned long long  list_allocs;        // heap allocations for renderlists and their arrays
+    unsigned long long  list_recycled;      // renderlists and arrays taken from the pool instead
+    unsigned long long  listvbo_allocs;     // display lists arrays or indices sub-allocated in a pooled VBO
+    unsigned long long  listvbo_blocks;     //  pooled VBO created for them
+    unsigned long long  listweld_vertices;  // duplicate display lists vertices removed by welding
+} gl4es_counters_t;
+
+#define GL4ES_COUNTERS_CURRENT      0   // current frame, still counting
+#define GL4ES_COUNTERS_LASTFRAME    1   // last complete frame
+#define GL4ES_COUNTERS_TOTAL        2   // everything since start (or last reset)
+
+// get one set of counters
+void gl4es_getcounters(int which, gl4es_counters_t *counters);
+// reset all counters
+void gl4es_resetcounters(void);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef _GL4ESINCLUDE_NULLDRV_H_
+#define _GL4ESINCLUDE_NULLDRV_H_
+
+// Built-in "null" GLES backend, selected with LIBGL_NULLDRIVER=1 (or 2 to also keep a call log)
+// All GLES entry points are no-op that only record what gl4es asked the driver to do,
+// so the CPU cost of gl4es itself can be measured without EGL or a GPU.
+
+typedef struct {
+    unsigned int        frames;         // number of eglSwapBuffers seen
+    unsigned long long  calls;          // total number of GLES calls
+    unsigned long long  draws;          // number of draw (each sub-draw of a MultiDraw counts)
+    unsigned long long  vertices;       // vertices (or indices) sent by the draws
+    unsigned long long  buffer_bytes;   // bytes uploaded with glBufferData / glBufferSubData
+    unsigned long long  texture_bytes;  // bytes uploaded with glTexImage2D / glTexSubImage2D / compressed variants
+} gl4es_nulldrv_stats_t;
+
+// get the counters accumulated since last reset
+void gl4es_nulldrv_getstats(gl4es_nulldrv_stats_t *stats);
+// get the number of calls to one GLES function (name without OES/EXT suffix), 0 if unknown
+unsigned long long gl4es_nulldrv_getcallcount(const char *name);
+// reset all counters and the call log
+void gl4es_nulldrv_reset(void);
+// write the call log as text, one call per line (needs LIBGL_NULLDRIVER=2). Return the number of entries written, -1 on error
+int gl4es_nulldrv_dumplog(const char *filename);
+
+#endif
@@ -1,6 +1,9 @@
 
 #include "egl.h"
 #include "../gl/loader.h"
+#include "../gl/counters.h"
+#include "../gl/perflog.h"
+#include "../gl/tracer.h"
 #include "../glx/hardext.h"
 
 #ifndef AliasExport
@@ -191,7 +194,11 @@ EGLBoolean gl4es_eglWaitNative(EGLint engine) {
 
 EGLBoolean gl4es_eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
     LOAD_EGL(eglSwapBuffers);
-    return egl_eglSwapBuffers(dpy, surface);
+    EGLBoolean ret = egl_eglSwapBuffers(dpy, surface);
+    counters_frame();
+    perflog_frame();
+    tracer_frame();
+    return ret;
 }
 
 EGLBoolean gl4es_eglCopyBuffers(EGLDisplay dpy, EGLSurface surface, EGLNativePixmapType target) {
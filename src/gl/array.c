@@ -422,15 +422,196 @@ GLfloat *copy_eval_float2(GLenum target, GLint ustride, GLint uorder,
     return out;
 }
 
-void getminmax_indices_us(const GLushort *indices, GLsizei *max, GLsizei *min, GLsizei count) {
-    if (!count) return;
-    *max = indices[0];
-    *min = indices[0];
+// Index range scans. Large draws scan all their indices, so there are SIMD versions, selected at runtime
+static void getminmax_us_c(const GLushort *indices, GLsizei *max, GLsizei *min, GLsizei count) {
+    GLushort mn = indices[0], mx = indices[0];
+    for (int i = 1; i < count; i++) {
+        GLushort n = indices[i];
+        if (n < mn) mn = n;
+        if (n > mx) mx = n;
+    }
+    *min = mn;
+    *max = mx;
+}
+static void getminmax_ui_c(const GLuint *indices, GLsizei *max, GLsizei *min, GLsizei count) {
+    GLuint mn = indices[0], mx = indices[0];
     for (int i = 1; i < count; i++) {
-        GLsizei n = indices[i];
-        if( n < *min) *min = n;
-        if (n > *max) *max = n;
+        GLuint n = indices[i];
+        if (n < mn) mn = n;
+        if (n > mx) mx = n;
     }
+    *min = mn;
+    *max = mx;
+}
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#if !defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_NEON
+#define HWCAP_NEON  (1<<12)
+#endif
+#endif
+static void getminmax_us_neon(const GLushort *indices, GLsizei *max, GLsizei *min, GLsizei count) {
+    GLushort mn = indices[0], mx = indices[0];
+    int i = 0;
+    if(count>=16) {
+        uint16x8_t vmin = vld1q_u16(indices);
+        uint16x8_t vmax = vmin;
+        for (i = 8; i+8 <= count; i+=8) {
+            uint16x8_t v = vld1q_u16(indices+i);
+            vmin = vminq_u16(vmin, v);
+            vmax = vmaxq_u16(vmax, v);
+        }
+#ifdef __aarch64__
+        mn = vminvq_u16(vmin);
+        mx = vmaxvq_u16(vmax);
+#else
+        uint16x4_t m = vpmin_u16(vget_low_u16(vmin), vget_high_u16(vmin));
+        m = vpmin_u16(m, m);
+        m = vpmin_u16(m, m);
+        mn = vget_lane_u16(m, 0);
+        m = vpmax_u16(vget_low_u16(vmax), vget_high_u16(vmax));
+        m = vpmax_u16(m, m);
+        m = vpmax_u16(m, m);
+        mx = vget_lane_u16(m, 0);
+#endif
+    }
+    for (; i < count; i++) {
+        GLushort n = indices[i];
+        if (n < mn) mn = n;
+        if (n > mx) mx = n;
+    }
+    *min = mn;
+    *max = mx;
+}
+static void getminmax_ui_neon(const GLuint *indices, GLsizei *max, GLsizei *min, GLsizei count) {
+    GLuint mn = indices[0], mx = indices[0];
+    int i = 0;
+    if(count>=8) {
+        uint32x4_t vmin = vld1q_u32(indices);
+        uint32x4_t vmax = vmin;
+        for (i = 4; i+4 <= count; i+=4) {
+            uint32x4_t v = vld1q_u32(indices+i);
+            vmin = vminq_u32(vmin, v);
+            vmax = vmaxq_u32(vmax, v);
+        }
+#ifdef __aarch64__
+        mn = vminvq_u32(vmin);
+        mx = vmaxvq_u32(vmax);
+#else
+        uint32x2_t m = vpmin_u32(vget_low_u32(vmin), vget_high_u32(vmin));
+        m = vpmin_u32(m, m);
+        mn = vget_lane_u32(m, 0);
+        m = vpmax_u32(vget_low_u32(vmax), vget_high_u32(vmax));
+        m = vpmax_u32(m, m);
+        mx = vget_lane_u32(m, 0);
+#endif
+    }
+    for (; i < count; i++) {
+        GLuint n = indices[i];
+        if (n < mn) mn = n;
+        if (n > mx) mx = n;
+    }
+    *min = mn;
+    *max = mx;
+}
+#endif // __ARM_NEON
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+// SSE2 only has signed 16 and 32 bits compares, so values are biased to use them as unsigned
+static void __attribute__((target("sse2"))) getminmax_us_sse2(const GLushort *indices, GLsizei *max, GLsizei *min, GLsizei count) {
+    GLushort mn = indices[0], mx = indices[0];
+    int i = 0;
+    if(count>=16) {
+        const __m128i bias = _mm_set1_epi16((short)0x8000);
+        __m128i vmin = _mm_xor_si128(_mm_loadu_si128((const __m128i*)indices), bias);
+        __m128i vmax = vmin;
+        for (i = 8; i+8 <= count; i+=8) {
+            __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(indices+i)), bias);
+            vmin = _mm_min_epi16(vmin, v);
+            vmax = _mm_max_epi16(vmax, v);
+        }
+        GLushort tmin[8], tmax[8];
+        _mm_storeu_si128((__m128i*)tmin, _mm_xor_si128(vmin, bias));
+        _mm_storeu_si128((__m128i*)tmax, _mm_xor_si128(vmax, bias));
+        for (int k = 0; k < 8; k++) {
+            if (tmin[k] < mn) mn = tmin[k];
+            if (tmax[k] > mx) mx = tmax[k];
+        }
+    }
+    for (; i < count; i++) {
+        GLushort n = indices[i];
+        if (n < mn) mn = n;
+        if (n > mx) mx = n;
+    }
+    *min = mn;
+    *max = mx;
+}
+static void __attribute__((target("sse2"))) getminmax_ui_sse2(const GLuint *indices, GLsizei *max, GLsizei *min, GLsizei count) {
+    GLuint mn = indices[0], mx = indices[0];
+    int i = 0;
+    if(count>=8) {
+        const __m128i bias = _mm_set1_epi32((int)0x80000000);
+        __m128i vmin = _mm_xor_si128(_mm_loadu_si128((const __m128i*)indices), bias);
+        __m128i vmax = vmin;
+        for (i = 4; i+4 <= count; i+=4) {
+            __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(indices+i)), bias);
+            __m128i lt = _mm_cmplt_epi32(v, vmin);
+            __m128i gt = _mm_cmpgt_epi32(v, vmax);
+            vmin = _mm_or_si128(_mm_and_si128(lt, v), _mm_andnot_si128(lt, vmin));
+            vmax = _mm_or_si128(_mm_and_si128(gt, v), _mm_andnot_si128(gt, vmax));
+        }
+        GLuint tmin[4], tmax[4];
+        _mm_storeu_si128((__m128i*)tmin, _mm_xor_si128(vmin, bias));
+        _mm_storeu_si128((__m128i*)tmax, _mm_xor_si128(vmax, bias));
+        for (int k = 0; k < 4; k++) {
+            if (tmin[k] < mn) mn = tmin[k];
+            if (tmax[k] > mx) mx = tmax[k];
+        }
+    }
+    for (; i < count; i++) {
+        GLuint n = indices[i];
+        if (n < mn) mn = n;
+        if (n > mx) mx = n;
+    }
+    *min = mn;
+    *max = mx;
+}
+#endif // x86
+
+static void (*getminmax_us)(const GLushort *indices, GLsizei *max, GLsizei *min, GLsizei count) = getminmax_us_c;
+static void (*getminmax_ui)(const GLuint *indices, GLsizei *max, GLsizei *min, GLsizei count) = getminmax_ui_c;
+
+const char* select_indices_scan(int simd) {
+    getminmax_us = getminmax_us_c;
+    getminmax_ui = getminmax_ui_c;
+    if(!simd)
+        return "C";
+#if defined(__ARM_NEON)
+#if !defined(__aarch64__) && defined(__linux__)
+    if(getauxval(AT_HWCAP) & HWCAP_NEON)
+#endif
+    {
+        getminmax_us = getminmax_us_neon;
+        getminmax_ui = getminmax_ui_neon;
+        return "NEON";
+    }
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();   // can run from a constructor, before libgcc has filled the cpu model
+    if(__builtin_cpu_supports("sse2")) {
+        getminmax_us = getminmax_us_sse2;
+        getminmax_ui = getminmax_ui_sse2;
+        return "SSE2";
+    }
+#endif
+    return "C";
+}
+
+void getminmax_indices_us(const GLushort *indices, GLsizei *max, GLsizei *min, GLsizei count) {
+    if (!count) return;
+    getminmax_us(indices, max, min, count);
 }
 void normalize_indices_us(GLushort *indices, GLsizei *max, GLsizei *min, GLsizei count) {
     getminmax_indices_us(indices, max, min, count);
@@ -441,13 +622,7 @@ void normalize_indices_us(GLushort *indices, GLsizei *max, GLsizei *min, GLsizei
 
 void getminmax_indices_ui(const GLuint *indices, GLsizei *max, GLsizei *min, GLsizei count) {
     if (!count) return;
-    *max = indices[0];
-    *min = indices[0];
-    for (int i = 1; i < count; i++) {
-        GLsizei n = indices[i];
-        if( n < *min) *min = n;
-        if (n > *max) *max = n;
-    }
+    getminmax_ui(indices, max, min, count);
 }
 void normalize_indices_ui(GLuint *indices, GLsizei *max, GLsizei *min, GLsizei count) {
     getminmax_indices_ui(indices, max, min, count);
@@ -25,6 +25,8 @@ void copy_gl_pointer_bytecolor_noalloc(void* dest, vertexattrib_t *ptr, GLsizei
 void copy_gl_pointer_raw_noalloc(void* dest, vertexattrib_t *ptr, GLsizei width, GLsizei skip, GLsizei count);
 void copy_gl_pointer_tex_noalloc(void* dest, vertexattrib_t *ptr, GLsizei width, GLsizei skip, GLsizei count);
 GLfloat *gl_pointer_index(vertexattrib_t *ptr, GLint index);
+// select the SIMD (if simd and available) or C version of the index scans, return the name of the selected one
+const char* select_indices_scan(int simd);
 void normalize_indices_us(GLushort *indices, GLsizei *max, GLsizei *min, GLsizei count);
 void getminmax_indices_us(const GLushort *indices, GLsizei *max, GLsizei *min, GLsizei count);
 void normalize_indices_ui(GLuint *indices, GLsizei *max, GLsizei *min, GLsizei count);
@@ -372,10 +372,7 @@ void gl4es_blitTexture(GLuint texture,
 
     gl4es_glPushAttrib(GL_TEXTURE_BIT | GL_ENABLE_BIT | GL_TRANSFORM_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
 
-    if(glstate->gleshard->active) {
-        glstate->gleshard->active = 0;
-        gles_glActiveTexture(GL_TEXTURE0);
-    }
+    gles_glActiveTexture(GL_TEXTURE0);
 
     GLint depthwrite = glstate->depth.mask;
 
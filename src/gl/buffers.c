@@ -3,7 +3,9 @@
 
 #include "khash.h"
 #include "../glx/hardext.h"
+#include "array.h"
 #include "attributes.h"
+#include "counters.h"
 #include "debug.h"
 #include "gl4es.h"
 #include "glstate.h"
@@ -131,6 +133,10 @@ void APIENTRY_GL4ES gl4es_glGenBuffers(GLsizei n, GLuint * buffers) {
         buff->access = GL_READ_WRITE;
         buff->mapped = 0;
         buff->real_buffer = 0;
+        buff->quads_buffer = 0;
+        buff->quads_count = 0;
+        buff->minmax_count = 0;
+        buff->minmax_next = 0;
     }
 }
 
@@ -169,6 +175,10 @@ void VISIBLE glBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
             buff->access = GL_READ_WRITE;
             buff->mapped = 0;
             buff->real_buffer = 0;
+            buff->quads_buffer = 0;
+            buff->quads_count = 0;
+            buff->minmax_count = 0;
+            buff->minmax_next = 0;
         }
         else {
             buff = kh_value(list, k);
@@ -224,6 +234,10 @@ void VISIBLE glBindBuffersRange(GLenum target, GLuint first, GLsizei count, cons
                 buff->access = GL_READ_WRITE;
                 buff->mapped = 0;
                 buff->real_buffer = 0;
+                buff->quads_buffer = 0;
+                buff->quads_count = 0;
+                buff->minmax_count = 0;
+                buff->minmax_next = 0;
             }
             else {
                 buff = kh_value(list, k);
@@ -279,6 +293,10 @@ void VISIBLE glBindBuffersBase(GLenum target, GLuint first, GLsizei count, const
                 buff->access = GL_READ_WRITE;
                 buff->mapped = 0;
                 buff->real_buffer = 0;
+                buff->quads_buffer = 0;
+                buff->quads_count = 0;
+                buff->minmax_count = 0;
+                buff->minmax_next = 0;
             }
             else {
                 buff = kh_value(list, k);
@@ -329,6 +347,10 @@ void VISIBLE glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLint
             buff->access = GL_READ_WRITE;
             buff->mapped = 0;
             buff->real_buffer = 0;
+            buff->quads_buffer = 0;
+            buff->quads_count = 0;
+            buff->minmax_count = 0;
+            buff->minmax_next = 0;
         }
         else {
             buff = kh_value(list, k);
@@ -379,6 +401,10 @@ void APIENTRY_GL4ES gl4es_glBindBuffer(GLenum target, GLuint buffer) {
             buff->access = GL_READ_WRITE;
             buff->mapped = 0;
             buff->real_buffer = 0;
+            buff->quads_buffer = 0;
+            buff->quads_count = 0;
+            buff->minmax_count = 0;
+            buff->minmax_next = 0;
         } else {
             buff = kh_value(list, k);
             buff->type = target;    //TODO: check if old binding?
@@ -439,6 +465,7 @@ void APIENTRY_GL4ES gl4es_glBufferData(GLenum target, GLsizeiptr size, const GLv
     buff->access = GL_READ_WRITE;
     if (data)
         memcpy(buff->data, data, size);
+    buffer_changed(buff);
     // update binded VA
     for (int i=0; i<hardext.maxvattrib; ++i) {
         vertexattrib_t *v = &glstate->vao->vertexattrib[i];
@@ -489,6 +516,7 @@ void APIENTRY_GL4ES gl4es_glNamedBufferData(GLuint buffer, GLsizeiptr size, cons
     buff->access = GL_READ_WRITE;
     if (data)
         memcpy(buff->data, data, size);
+    buffer_changed(buff);
     // update binded VA
     for (int i=0; i<hardext.maxvattrib; ++i) {
         vertexattrib_t *v = &glstate->vao->vertexattrib[i];
@@ -529,6 +557,7 @@ void APIENTRY_GL4ES gl4es_glBufferSubData(GLenum target, GLintptr offset, GLsize
     }
         
     memcpy((char*)buff->data + offset, data, size);
+    buffer_changed(buff);
     noerrorShim();
 }
 void APIENTRY_GL4ES gl4es_glNamedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const GLvoid * data) {
@@ -551,6 +580,7 @@ void APIENTRY_GL4ES gl4es_glNamedBufferSubData(GLuint buffer, GLintptr offset, G
         gles_glBufferSubData(buff->type, offset, size, data);
     }
     memcpy((char*)buff->data + offset, data, size);
+    buffer_changed(buff);
     noerrorShim();
 }
 
@@ -576,6 +606,8 @@ void APIENTRY_GL4ES gl4es_glDeleteBuffers(GLsizei n, const GLuint * buffers) {
                         LOAD_GLES(glDeleteBuffers);
                         deleteSingleBuffer(buff->real_buffer);
                     }
+                    if(buff->quads_buffer)
+                        deleteSingleBuffer(buff->quads_buffer);
                     if (glstate->vao->vertex == buff)
                         glstate->vao->vertex = NULL;
                     if (glstate->vao->elements == buff)
@@ -693,6 +725,7 @@ void* APIENTRY_GL4ES gl4es_glMapBuffer(GLenum target, GLenum access) {
 	buff->access = access;	// not used
 	buff->mapped = 1;
     buff->ranged = 0;
+    buffer_changed(buff);
 	noerrorShim();
 	return buff->data;		// Not nice, should do some copy or something probably
 }
@@ -711,6 +744,7 @@ void* APIENTRY_GL4ES gl4es_glMapNamedBuffer(GLuint buffer, GLenum access) {
 	buff->access = access;	// not used
 	buff->mapped = 1;
     buff->ranged = 0;
+    buffer_changed(buff);
 	noerrorShim();
 	return buff->data;		// Not nice, should do some copy or something probably
 }
@@ -861,6 +895,7 @@ void* APIENTRY_GL4ES gl4es_glMapBufferRange(GLenum target, GLintptr offset, GLsi
 	buff->access = access;
 	buff->mapped = 1;
     buff->ranged = 1;
+    buffer_changed(buff);
     buff->offset = offset;
     buff->length = length;
 	noerrorShim();
@@ -935,6 +970,7 @@ void APIENTRY_GL4ES gl4es_glCopyBufferSubData(GLenum readTarget, GLenum writeTar
      */
 
     memcpy((char*)writebuff->data + writeOffset, (char*)readbuff->data + readOffset, size);
+    buffer_changed(writebuff);
 
     if (writebuff->real_buffer && (writebuff->type == GL_ARRAY_BUFFER || writebuff->type == GL_ELEMENT_ARRAY_BUFFER) &&
         writebuff->mapped && (writebuff->access == GL_WRITE_ONLY || writebuff->access == GL_READ_WRITE)) {
@@ -1009,14 +1045,79 @@ void realize_bufferIndex()
     }
 }
 
+// the native vertex arrays that use that buffer need to have their attributes set again
+static void hardvao_forget(hardvao_t *h, GLuint buffer) {
+    for (int i=0; i<hardext.maxvattrib; i++)
+        if(h->vertexattrib[i].real_buffer==buffer)
+            h->vertexattrib[i].real_buffer = HARD_UNKNOWN;
+    if(h->elements==buffer)
+        h->elements = 0;
+}
+
 void deleteSingleBuffer(GLuint buffer) {
    LOAD_GLES(glDeleteBuffers);
+   if(hardext.esversion>2) {
+       glvao_t *vao;
+       hardvao_forget(&glstate->gleshard->defaultvao, buffer);
+       kh_foreach_value(glstate->vaos, vao,
+           for (int i=0; i<HARDVAO_LAYOUTS; i++)
+               if(vao->hard[i])
+                   hardvao_forget(vao->hard[i], buffer);
+       )
+   }
    if(glstate->bind_buffer.index == buffer) glstate->bind_buffer.index = 0;
    else if(glstate->bind_buffer.want_index == buffer) glstate->bind_buffer.want_index = 0;
    else if(glstate->bind_buffer.array == buffer) glstate->bind_buffer.array = 0;
    gles_glDeleteBuffers(1, &buffer);
 }
 
+void buffer_changed(glbuffer_t *buff)
+{
+    buff->quads_count = 0;
+    buff->minmax_count = 0;
+    buff->minmax_next = 0;
+}
+
+void minmax_indices(GLenum type, const void *indices, GLsizei count, GLsizei *max, GLsizei *min)
+{
+    glbuffer_t *buff = glstate->vao->elements;
+    GLsizeiptr isize = (type==GL_UNSIGNED_INT)?sizeof(GLuint):sizeof(GLushort);
+    // a mapped buffer can change at any time
+    if(!buff || buff->mapped || !buff->data || (const char*)indices<(const char*)buff->data
+        || (const char*)indices+count*isize>(const char*)buff->data+buff->size) {
+        COUNTER_INC(index_scans);
+        if(type==GL_UNSIGNED_INT)
+            getminmax_indices_ui((const GLuint*)indices, max, min, count);
+        else
+            getminmax_indices_us((const GLushort*)indices, max, min, count);
+        return;
+    }
+    uintptr_t offset = (uintptr_t)indices - (uintptr_t)buff->data;
+    for (int i=0; i<buff->minmax_count; i++) {
+        minmax_cache_t *c = &buff->minmax[i];
+        if(c->offset==offset && c->count==count && c->type==type) {
+            COUNTER_INC(index_scans_cached);
+            *min = c->min;
+            *max = c->max;
+            return;
+        }
+    }
+    COUNTER_INC(index_scans);
+    if(type==GL_UNSIGNED_INT)
+        getminmax_indices_ui((const GLuint*)indices, max, min, count);
+    else
+        getminmax_indices_us((const GLushort*)indices, max, min, count);
+    minmax_cache_t *c = &buff->minmax[buff->minmax_next];
+    buff->minmax_next = (buff->minmax_next+1)%MINMAX_CACHE;
+    if(buff->minmax_count<MINMAX_CACHE)
+        ++buff->minmax_count;
+    c->type = type;
+    c->offset = offset;
+    c->count = count;
+    c->min = *min;
+    c->max = *max;
+}
+
 void unboundBuffers()
 {
     if(!glstate->bind_buffer.used)
@@ -1164,6 +1265,9 @@ void APIENTRY_GL4ES gl4es_glDeleteVertexArrays(GLsizei n, const GLuint *arrays)
                 if (k != kh_end(list)) {
                     glvao = kh_value(list, k);
                     VaoSharedClear(glvao);
+                    VaoHardClear(glvao);
+                    if(glstate->vao == glvao)
+                        glstate->vao = glstate->defaultvao;
                     kh_del(glvao, list, k);
                     //free(glvao);  //let the use delete those
                 }
@@ -1246,6 +1350,64 @@ void VaoSharedClear(glvao_t *vao) {
     vao->shared_arrays = NULL;
 }
 
+void VaoHardClear(glvao_t *vao) {
+    LOAD_GLES3(glDeleteVertexArrays);
+    for (int i=0; i<HARDVAO_LAYOUTS; i++) {
+        hardvao_t *h = vao->hard[i];
+        if(!h)
+            continue;
+        if(glstate && glstate->gleshard->hardvao==h)
+            realize_hardvao(NULL, 0);
+        if(h->id && gles_glDeleteVertexArrays)
+            gles_glDeleteVertexArrays(1, &h->id);
+        free(h);
+        vao->hard[i] = NULL;
+    }
+    vao->hard_next = 0;
+}
+
+void realize_hardvao(glvao_t *vao, GLuint layout) {
+    gleshard_t *hard = glstate->gleshard;
+    hardvao_t *h = &hard->defaultvao;
+    if(vao && hardext.esversion>2 && !globals4es.nohardvao) {
+        h = NULL;
+        for (int i=0; i<HARDVAO_LAYOUTS && !h; i++)
+            if(vao->hard[i] && vao->hard[i]->layout==layout)
+                h = vao->hard[i];
+        if(!h) {
+            LOAD_GLES3(glGenVertexArrays);
+            int idx = vao->hard_next;
+            h = vao->hard[idx];
+            if(!h && gles_glGenVertexArrays) {
+                GLuint id = 0;
+                gles_glGenVertexArrays(1, &id);
+                if(id) {
+                    h = vao->hard[idx] = (hardvao_t*)calloc(1, sizeof(hardvao_t));
+                    h->id = id;
+                }
+            }
+            if(h) {
+                // a recycled one keeps its attributes, so only the difference with the new layout will be sent
+                vao->hard_next = (idx+1)%HARDVAO_LAYOUTS;
+                h->layout = layout;
+            } else
+                h = &hard->defaultvao;
+        }
+    }
+    if(h==hard->hardvao)
+        return;
+    DBG(SHUT_LOGD("Bind native vertex array %u (layout %x)\n", h->id, layout);)
+    LOAD_GLES3(glBindVertexArray);
+    // the element array binding is part of the vertex array
+    hard->hardvao->elements = glstate->bind_buffer.index;
+    gles_glBindVertexArray(h->id);
+    hard->hardvao = h;
+    hard->vertexattrib = h->vertexattrib;
+    glstate->bind_buffer.index = h->elements;
+    hard->buffer[HARD_BUF_ELEMENT_ARRAY] = h->elements;
+    glstate->bind_buffer.used = (glstate->bind_buffer.index && glstate->bind_buffer.array)?1:0;
+}
+
 void VaoInit(glvao_t *vao) {
     memset(vao, 0, sizeof(glvao_t));
     for (int i=0; i<hardext.maxvattrib; i++) {
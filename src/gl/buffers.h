@@ -6,6 +6,16 @@
 #include "gles.h"
 
 // VBO *****************
+// a cached index range scan (see minmax_indices)
+typedef struct {
+    GLenum      type;
+    uintptr_t   offset;
+    GLsizei     count;
+    GLsizei     min;
+    GLsizei     max;
+} minmax_cache_t;
+#define MINMAX_CACHE    8
+
 typedef struct {
     GLuint      buffer;
     GLuint      real_buffer;
@@ -27,7 +37,16 @@ typedef struct {
     GLintptr    mapped_offset;
     int         mapping_flags;
     GLvoid*     original_data;
-
+    // GL_QUADS indices converted to GL_TRIANGLES, cached in a GLES buffer (see drawing.c)
+    GLuint      quads_buffer;
+    GLenum      quads_type;
+    uintptr_t   quads_offset;
+    GLsizei     quads_count;    // 0 if nothing cached
+    GLuint      quads_len;      // max(indices)+1
+    // min/max of the last index ranges scanned in the buffer
+    minmax_cache_t minmax[MINMAX_CACHE];
+    int         minmax_count;
+    int         minmax_next;    // next entry to replace
 } glbuffer_t;
 
 KHASH_MAP_DECLARE_INT(buff, glbuffer_t *);
@@ -89,6 +108,11 @@ void unboundBuffers();
 GLuint wantBufferIndex(GLuint buffer);
 // Bind the wanted index buffer if needed
 void realize_bufferIndex();
+// the content of the buffer changed, drop what was derived from it
+void buffer_changed(glbuffer_t *buff);
+// min and max of count indices of type (GL_UNSIGNED_SHORT or GL_UNSIGNED_INT),
+// cached when they are in the binded element buffer
+void minmax_indices(GLenum type, const void *indices, GLsizei count, GLsizei *max, GLsizei *min);
 
 
 // Pointer..... ****** => map them in vertexattrib (even with GLES1.1). So no more pointer_state_t, use vertexattrib_t
@@ -201,6 +225,15 @@ typedef struct {
 } pointer_cache_t;
 
 // VAO ****************
+// Native GLES3 vertex array, with a copy of what has been set in it (attributes and element array binding)
+typedef struct {
+    GLuint          id;         // GLES name, 0 for the default vertex array
+    GLuint          layout;     // attributes used by the programs it's set up for (1 bit per attribute)
+    GLuint          elements;   // element array buffer bound in it
+    vertexattrib_t  vertexattrib[MAX_VATTRIB];
+} hardvao_t;
+#define HARDVAO_LAYOUTS 4   // native vertex arrays per VAO, for different attributes layout
+
 typedef struct {
     GLuint           array;
     // buffer state
@@ -229,10 +262,17 @@ typedef struct {
     // TODO: Cache VA also?
     glbuffer_t *read;
     glbuffer_t *write;
+    // native vertex arrays (ES3), one per program attributes layout
+    hardvao_t  *hard[HARDVAO_LAYOUTS];
+    int         hard_next;  // next one to recycle
 } glvao_t;
 
 void VaoSharedClear(glvao_t *vao);
 void VaoInit(glvao_t *vao);
+// delete the native vertex arrays of the vao
+void VaoHardClear(glvao_t *vao);
+// bind the native vertex array of vao for the attributes layout (or the default one if vao is NULL)
+void realize_hardvao(glvao_t *vao, GLuint layout);
 
 KHASH_MAP_DECLARE_INT(glvao, glvao_t*);
 
@@ -17,6 +17,7 @@ extern "C" {
 #define GL_TEXTURE_1D               0x0DE0
 #define GL_TEXTURE_2D               0x0DE1
 #define GL_TEXTURE_3D               0x806F
+#define GL_TEXTURE_2D_ARRAY         0x8C1A
 #define GL_TEXTURE_WRAP_S           0x2802
 #define GL_TEXTURE_WRAP_T           0x2803
 #define GL_TEXTURE_WRAP_R           0x8072
@@ -448,6 +449,8 @@ extern "C" {
 #define GL_POLYGON_OFFSET_UNITS  0x2A00
 #define GL_POLYGON_OFFSET_POINT  0x2A01
 #define GL_POLYGON_OFFSET_LINE   0x2A02
+#define GL_PRIMITIVE_RESTART_FIXED_INDEX 0x8D69
+#define GL_RASTERIZER_DISCARD    0x8C89
 
 /* Shader Source */
 #define GL_SHADING_LANGUAGE_VERSION       0x8B8C
@@ -577,6 +580,8 @@ extern "C" {
 #define GL_COPY_READ_BUFFER               GL_COPY_READ_BUFFER_BINDING
 #define GL_COPY_WRITE_BUFFER_BINDING      0x8F37
 #define GL_COPY_WRITE_BUFFER              GL_COPY_WRITE_BUFFER_BINDING
+#define GL_UNIFORM_BUFFER                 0x8A11
+#define GL_INVALID_INDEX                  0xFFFFFFFFu
 
 
 /* Framebuffers */
@@ -768,6 +773,7 @@ extern "C" {
 #define GL_FLOAT_MAT4                     0x8B5C
 #define GL_SAMPLER_2D                     0x8B5E
 #define GL_SAMPLER_CUBE                   0x8B60
+#define GL_SAMPLER_2D_SHADOW              0x8B62
 
 // Getter
 #define GL_NUM_EXTENSIONS                 0x821D
@@ -0,0 +1,84 @@
+#include "counters.h"
+
+#include <string.h>
+#include <time.h>
+
+#include "init.h"
+#include "logs.h"
+
+#define NCOUNTERS   (sizeof(gl4es_counters_t)/sizeof(unsigned long long))
+
+gl4es_counters_t counters = {0};
+
+static gl4es_counters_t counters_last = {0};
+static gl4es_counters_t counters_total = {0};
+static gl4es_counters_t counters_dump = {0};    // accumulated since last print
+
+unsigned long long counters_now() {
+#ifdef _WIN32
+    return (unsigned long long)clock()*(1000000000ULL/CLOCKS_PER_SEC);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec*1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+static void counters_accum(gl4es_counters_t *dst, const gl4es_counters_t *src) {
+    // the struct is only unsigned long long
+    unsigned long long *d = (unsigned long long*)dst;
+    const unsigned long long *s = (const unsigned long long*)src;
+    for (int i=0; i<NCOUNTERS; ++i)
+        d[i] += s[i];
+}
+
+static void counters_print(const gl4es_counters_t *c) {
+    SHUT_LOGD("counters (%llu frames): fpe switch %llu, fpe miss %llu, shader convert %llu (%.2fms), compile %llu (%.2fms), link %llu (%.2fms)\n",
+        c->frames, c->fpe_switches, c->fpe_misses, c->shader_converts, c->shader_convert_ns*1e-6,
+        c->shader_compiles, c->shader_compile_ns*1e-6, c->program_links, c->program_link_ns*1e-6);
+    SHUT_LOGD("counters: uniforms sent %llu, skipped %llu, pixel_convert %llu (%llu KB), renderlist flush %llu, alloc %llu, recycled %llu, state sent %llu, elided %llu\n",
+        c->uniforms_sent, c->uniforms_skipped, c->pixel_converts, c->pixel_convert_bytes/1024, c->renderlist_flushes,
+        c->list_allocs, c->list_recycled, c->state_sent, c->state_elided);
+    SHUT_LOGD("counters: arrays streamed %llu (%llu KB), stream orphans %llu, index scans %llu, cached %llu, fpe block %llu (%llu KB), merged draws %llu (from %llu), list vbo %llu (%llu blocks), welded vertices %llu\n",
+        c->stream_uploads, c->stream_bytes/1024, c->stream_orphans, c->index_scans, c->index_scans_cached,
+        c->fpe_ubo_uploads, c->fpe_ubo_bytes/1024, c->drawmerge_runs, c->drawmerge_draws, c->listvbo_allocs, c->listvbo_blocks, c->listweld_vertices);
+}
+
+void counters_frame() {
+    counters.frames = 1;
+    memcpy(&counters_last, &counters, sizeof(counters));
+    counters_accum(&counters_total, &counters);
+    memset(&counters, 0, sizeof(counters));
+    if(globals4es.counters) {
+        counters_accum(&counters_dump, &counters_last);
+        if(counters_dump.frames >= globals4es.counters) {
+            counters_print(&counters_dump);
+            memset(&counters_dump, 0, sizeof(counters_dump));
+        }
+    }
+}
+
+void gl4es_getcounters(int which, gl4es_counters_t *c) {
+    switch(which) {
+        case GL4ES_COUNTERS_CURRENT:
+            memcpy(c, &counters, sizeof(counters));
+            break;
+        case GL4ES_COUNTERS_LASTFRAME:
+            memcpy(c, &counters_last, sizeof(counters));
+            break;
+        case GL4ES_COUNTERS_TOTAL:
+            // also count the running frame
+            memcpy(c, &counters_total, sizeof(counters));
+            counters_accum(c, &counters);
+            break;
+        default:
+            memset(c, 0, sizeof(counters));
+    }
+}
+
+void gl4es_resetcounters(void) {
+    memset(&counters, 0, sizeof(counters));
+    memset(&counters_last, 0, sizeof(counters));
+    memset(&counters_total, 0, sizeof(counters));
+    memset(&counters_dump, 0, sizeof(counters));
+}
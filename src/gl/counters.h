@@ -0,0 +1,23 @@
+#ifndef _GL4ES_COUNTERS_H_
+#define _GL4ES_COUNTERS_H_
+
+#include <gl4escounters.h>
+#include "attributes.h"
+
+// counters of the current frame
+extern gl4es_counters_t counters;
+
+#define COUNTER_INC(name)       ++counters.name
+#define COUNTER_ADD(name, n)    counters.name += (n)
+// count one more "name", that started at t0 (from counters_now()), and add its duration to "time"
+#define COUNTER_TIME(name, time, t0)    {++counters.name; counters.time += counters_now()-(t0);}
+
+// monotonic time, in ns
+unsigned long long counters_now();
+// end of frame: roll the counters, and print them if LIBGL_COUNTERS is set
+void counters_frame();
+
+EXPORT void gl4es_getcounters(int which, gl4es_counters_t *c);
+EXPORT void gl4es_resetcounters(void);
+
+#endif // _GL4ES_COUNTERS_H_
@@ -1,5 +1,6 @@
 #include "../glx/hardext.h"
 #include "array.h"
+#include "drawmerge.h"
 #include "gl4es.h"
 #include "enum_info.h"
 #include "fpe.h"
@@ -9,6 +10,7 @@
 #include "list.h"
 #include "loader.h"
 #include "render.h"
+#include "stream.h"
 
 //#define DEBUG
 #ifdef DEBUG
@@ -72,6 +74,7 @@ renderlist_t *arrays_to_renderlist(renderlist_t *list, GLenum mode,
     list->mode_dimension = rendermode_dimensions(mode);
     list->len = count-skip;
     list->cap = count-skip;
+    list->pooled_arrays = 0;
 
     // check cache if any
     if(glstate->vao->shared_arrays)  {
@@ -273,21 +276,32 @@ static inline bool should_intercept_render(GLenum mode) {
 }
 
 GLuint len_indices(const GLushort *sindices, const GLuint *iindices, GLsizei count) {
-    GLuint len = 0;
-    if (sindices) {
-        for (int i=0; i<count; i++)
-            if (len<sindices[i]) len = sindices[i]; // get the len of the arrays
-    } else {
-        for (int i=0; i<count; i++)
-            if (len<iindices[i]) len = iindices[i]; // get the len of the arrays
-    }
-    return len+1;  // length is max(indices) + 1 !
+    GLsizei min, max = 0;
+    if (sindices)
+        minmax_indices(GL_UNSIGNED_SHORT, sindices, count, &max, &min);
+    else
+        minmax_indices(GL_UNSIGNED_INT, iindices, count, &max, &min);
+    return max+1;  // length is max(indices) + 1 !
 }
 
-static void glDrawElementsCommon(GLenum mode, GLint first, GLsizei count, GLuint len, const GLushort *sindices, const GLuint *iindices, int instancecount) {
+#define QUADS_TO_TRIANGLES(dst, src, count) \
+    for (int i=0, j=0; i+3<(count); i+=4, j+=6) {  \
+        dst[j+0] = src[i+0];                        \
+        dst[j+1] = src[i+1];                        \
+        dst[j+2] = src[i+2];                        \
+                                                    \
+        dst[j+3] = src[i+0];                        \
+        dst[j+4] = src[i+2];                        \
+        dst[j+5] = src[i+3];                        \
+    }
+
+// for indexed draws, [first, len) is the range of the indices when known (else first=0 and len=0)
+// if vbotype is not 0, the indices are of that type and already in the binded GLES index buffer,
+// sindices or iindices being the offset in it (so len must be given)
+static void glDrawElementsCommon(GLenum mode, GLint first, GLsizei count, GLuint len, const GLushort *sindices, const GLuint *iindices, GLenum vbotype, int instancecount) {
     if (glstate->raster.bm_drawing)
         bitmap_flush();
-    DBG(SHUT_LOGD("glDrawElementsCommon(%s, %d, %d, %d, %p, %p, %d)\n", PrintEnum(mode), first, count, len, sindices, iindices, instancecount);)
+    DBG(SHUT_LOGD("glDrawElementsCommon(%s, %d, %d, %d, %p, %p, %s, %d)\n", PrintEnum(mode), first, count, len, sindices, iindices, PrintEnum(vbotype), instancecount);)
     LOAD_GLES_FPE(glDrawElements);
     LOAD_GLES_FPE(glDrawArrays);
     LOAD_GLES_FPE(glNormalPointer);
@@ -327,28 +341,12 @@ if(count>500000) return;
         if (iindices) {
             gl4es_scratch(ilen*sizeof(GLuint));
             GLuint *tmp = (GLuint*)glstate->scratch;
-            for (int i=0, j=0; i+3<count; i+=4, j+=6) {
-                tmp[j+0] = iindices[i+0];
-                tmp[j+1] = iindices[i+1];
-                tmp[j+2] = iindices[i+2];
-
-                tmp[j+3] = iindices[i+0];
-                tmp[j+4] = iindices[i+2];
-                tmp[j+5] = iindices[i+3];
-            }
+            QUADS_TO_TRIANGLES(tmp, iindices, count);
             iindices = tmp;
         } else {
             gl4es_scratch(ilen*sizeof(GLushort));
             GLushort *tmp = (GLushort*)glstate->scratch;
-            for (int i=0, j=0; i+3<count; i+=4, j+=6) {
-                tmp[j+0] = sindices[i+0];
-                tmp[j+1] = sindices[i+1];
-                tmp[j+2] = sindices[i+2];
-
-                tmp[j+3] = sindices[i+0];
-                tmp[j+4] = sindices[i+2];
-                tmp[j+5] = sindices[i+3];
-            }
+            QUADS_TO_TRIANGLES(tmp, sindices, count);
             sindices = tmp;
         }
         count = ilen;
@@ -421,22 +419,37 @@ if(count>500000) return;
             else
                 ToBuffer(glstate->vao->first, glstate->vao->count);
         }
+        // remaining client arrays: upload the used vertex range in the streaming VBO
+        int streamed = 0;
+        if(hardext.esversion>1 && globals4es.streamvbo) {
+            GLsizei imin = first, imax = len-1;
+            if(!iindices && !sindices && !vbotype)
+                imax = first+count-1;
+            else if(!len && !vbotype) {
+                if(sindices)
+                    minmax_indices(GL_UNSIGNED_SHORT, sindices, count, &imax, &imin);
+                else
+                    minmax_indices(GL_UNSIGNED_INT, iindices, count, &imax, &imin);
+            }
+            streamed = stream_arrays(imin, imax);
+        }
 
         // POLYGON mode as LINE is "intercepted" and drawn using list
+        void* inds = (sindices?((void*)sindices):((void*)iindices));
+        GLenum itype = (vbotype)?vbotype:((sindices)?GL_UNSIGNED_SHORT:GL_UNSIGNED_INT);
         if(instancecount==1 || hardext.esversion==1) {
-            if(!iindices && !sindices)
+            if(!iindices && !sindices && !vbotype)
                 gles_glDrawArrays(mode, first, count);
             else
-                gles_glDrawElements(mode, count, (sindices)?GL_UNSIGNED_SHORT:GL_UNSIGNED_INT, (sindices?((void*)sindices):((void*)iindices)));
+                gles_glDrawElements(mode, count, itype, inds);
         } else {
-            if(!iindices && !sindices)
+            if(!iindices && !sindices && !vbotype)
                 fpe_glDrawArraysInstanced(mode, first, count,instancecount);
-            else {
-                void* tmp=(sindices?((void*)sindices):((void*)iindices));
-                GLenum t = (sindices)?GL_UNSIGNED_SHORT:GL_UNSIGNED_INT;
-                fpe_glDrawElementsInstanced(mode, count, t, tmp, instancecount);
-            }
+            else
+                fpe_glDrawElementsInstanced(mode, count, itype, inds, instancecount);
         }
+        if(streamed)
+            stream_done();
 
         for (int aa=0; aa<hardext.maxtex; aa++) {
             if (!IS_TEX2D(glstate->enable.texture[aa]) && (IS_ANYTEX(glstate->enable.texture[aa]))) {
@@ -451,6 +464,247 @@ if(count>500000) return;
     }
 }
 
+// can the indices of a draw stay in a GLES buffer (i.e. nothing will need to read them on the CPU side)
+static int indices_in_vbo() {
+    if(!globals4es.usevbo || glstate->render_mode == GL_SELECT || glstate->polygon_mode == GL_POINT)
+        return 0;
+    // BGRA and GL_DOUBLE arrays are converted using the range of the indices
+    for (int i=0; i<hardext.maxvattrib; i++) {
+        vertexattrib_t *w = &glstate->vao->vertexattrib[i];
+        if(w->enabled && (w->size==GL_BGRA || w->type==GL_DOUBLE))
+            return 0;
+    }
+    return 1;
+}
+
+// get the shared GL_QUADS index buffer, covering at least count vertices (0 if not possible)
+// quad n uses indices 4n+{0,1,2, 0,2,3}, so a draw starting on a multiple of 4 is just an offset in it
+static GLuint quad_indices(GLsizei count) {
+    if(count>65536)
+        return 0;
+    if(glstate->quad_indices_cap<count) {
+        LOAD_GLES(glGenBuffers);
+        LOAD_GLES(glBufferData);
+        if(!glstate->quad_indices)
+            gles_glGenBuffers(1, &glstate->quad_indices);
+        if(!glstate->quad_indices)
+            return 0;
+        GLsizei cap = 1024;
+        while(cap<count) cap<<=1;
+        gl4es_scratch(cap*3/2*sizeof(GLushort));
+        GLushort *p = (GLushort*)glstate->scratch;
+        for (int j=0; j<cap; j+=4) {
+            *(p++) = j + 0;
+            *(p++) = j + 1;
+            *(p++) = j + 2;
+
+            *(p++) = j + 0;
+            *(p++) = j + 2;
+            *(p++) = j + 3;
+        }
+        DBG(SHUT_LOGD("Quad indices buffer %d grown to %d vertices\n", glstate->quad_indices, cap);)
+        bindBuffer(GL_ELEMENT_ARRAY_BUFFER, glstate->quad_indices);
+        gles_glBufferData(GL_ELEMENT_ARRAY_BUFFER, cap*3/2*sizeof(GLushort), glstate->scratch, GL_STATIC_DRAW);
+        glstate->quad_indices_cap = cap;
+    }
+    return glstate->quad_indices;
+}
+
+static void glDrawQuadsArrays(GLint first, GLsizei count, int instancecount) {
+    GLuint old_index = wantBufferIndex(0);
+    GLuint ibo = ((first%4)==0 && indices_in_vbo())?quad_indices(first+count):0;
+    if(ibo) {
+        wantBufferIndex(ibo);
+        glDrawElementsCommon(GL_TRIANGLES, first, count*3/2, first+count, (GLushort*)(uintptr_t)(first*3/2*sizeof(GLushort)), NULL, GL_UNSIGNED_SHORT, instancecount);
+    } else {
+        // client side indices
+        static GLushort *indices = NULL;
+        static int indcnt = 0;
+        static int indfirst = 0;
+        int realfirst = ((first%4)==0)?0:first;
+        int realcount = count + (first-realfirst);
+        if((indcnt < realcount) || (indfirst!=realfirst)) {
+            if(indcnt < realcount) {
+                indcnt = realcount;
+                if (indices) free(indices);
+                indices = (GLushort*)malloc(sizeof(GLushort)*(indcnt*3/2));
+            }
+            indfirst = realfirst;
+            GLushort *p = indices;
+            for (int i=0, j=indfirst; i+3<indcnt; i+=4, j+=4) {
+                    *(p++) = j + 0;
+                    *(p++) = j + 1;
+                    *(p++) = j + 2;
+
+                    *(p++) = j + 0;
+                    *(p++) = j + 2;
+                    *(p++) = j + 3;
+            }
+        }
+        wantBufferIndex(0);
+        glDrawElementsCommon(GL_TRIANGLES, first, count*3/2, first+count, indices+(first-indfirst)*3/2, NULL, 0, instancecount);
+    }
+    wantBufferIndex(old_index);
+}
+
+// draw GL_QUADS with indices from the binded element buffer, using a GL_TRIANGLES conversion cached with the buffer
+// (one range per buffer, dropped when the buffer changes). Return 0 if not possible
+static int glDrawQuadsElements(GLenum type, const void *indices, GLsizei count, int instancecount) {
+    glbuffer_t *buff = glstate->vao->elements;
+    if(!buff || buff->mapped || !indices_in_vbo())
+        return 0;
+    GLsizeiptr isize = (type==GL_UNSIGNED_INT)?sizeof(GLuint):sizeof(GLushort);
+    uintptr_t offset = (uintptr_t)indices;
+    if(offset+count*isize > (uintptr_t)buff->size)
+        return 0;
+    GLuint old_index = wantBufferIndex(0);
+    if(buff->quads_count!=count || buff->quads_offset!=offset || buff->quads_type!=type) {
+        LOAD_GLES(glGenBuffers);
+        LOAD_GLES(glBufferData);
+        if(!buff->quads_buffer)
+            gles_glGenBuffers(1, &buff->quads_buffer);
+        if(!buff->quads_buffer) {
+            wantBufferIndex(old_index);
+            return 0;
+        }
+        const void *src = (const char*)buff->data + offset;
+        gl4es_scratch(count*3/2*isize);
+        if(type==GL_UNSIGNED_INT) {
+            GLuint *tmp = (GLuint*)glstate->scratch;
+            const GLuint *iindices = (const GLuint*)src;
+            QUADS_TO_TRIANGLES(tmp, iindices, count);
+            buff->quads_len = len_indices(NULL, iindices, count);
+        } else {
+            GLushort *tmp = (GLushort*)glstate->scratch;
+            const GLushort *sindices = (const GLushort*)src;
+            QUADS_TO_TRIANGLES(tmp, sindices, count);
+            buff->quads_len = len_indices(sindices, NULL, count);
+        }
+        DBG(SHUT_LOGD("Caching GL_QUADS indices of buffer %d (offset=%p, count=%d) in %d\n", buff->buffer, (void*)offset, count, buff->quads_buffer);)
+        bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buff->quads_buffer);
+        gles_glBufferData(GL_ELEMENT_ARRAY_BUFFER, count*3/2*isize, glstate->scratch, GL_STATIC_DRAW);
+        buff->quads_type = type;
+        buff->quads_offset = offset;
+        buff->quads_count = count;
+    }
+    wantBufferIndex(buff->quads_buffer);
+    glDrawElementsCommon(GL_TRIANGLES, 0, count*3/2, buff->quads_len, NULL, NULL, type, instancecount);
+    wantBufferIndex(old_index);
+    return 1;
+}
+
+// draw all the ranges of a glMultiDrawArrays (firsts) or glMultiDrawElements (type / indices) with 1 glDrawElements
+// independant primitives are simply concatenated, strips / fans / loops are separated by a primitive restart index (GLES3)
+// Return 0 if not possible, each range has to be drawn on its own
+static int multidraw_single(GLenum mode, const GLint *firsts, const GLsizei *counts, GLenum type, const void * const *indices, GLsizei primcount) {
+    if(primcount<2 || glstate->render_mode == GL_SELECT)
+        return 0;
+    int restart = 0;
+    switch(mode) {
+        case GL_POINTS:
+        case GL_LINES:
+        case GL_TRIANGLES:
+        case GL_QUADS:
+            break;
+        case GL_LINE_STRIP:
+        case GL_LINE_LOOP:
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN:
+        case GL_QUAD_STRIP:
+        case GL_POLYGON:
+            if(hardext.esversion<3)
+                return 0;
+            restart = 1;
+            break;
+        default:
+            return 0;
+    }
+    if(!firsts && type!=GL_UNSIGNED_BYTE && type!=GL_UNSIGNED_SHORT && type!=GL_UNSIGNED_INT)
+        return 0;
+    // 1st pass: size of the index list, and vertex range
+    GLsizei ilen = 0, ranges = 0;
+    GLsizei imin = 0x7fffffff, imax = -1;
+    for (int i=0; i<primcount; i++) {
+        if(counts[i]<0)
+            return 0;   // error, let the normal path deal with it
+        GLsizei count = adjust_vertices(mode, counts[i]);
+        if(!count)
+            continue;
+        GLsizei mi, ma;
+        if(firsts) {
+            mi = firsts[i];
+            ma = firsts[i]+count-1;
+        } else {
+            const void *src = (glstate->vao->elements)?((char*)glstate->vao->elements->data + (uintptr_t)indices[i]):indices[i];
+            if(type==GL_UNSIGNED_BYTE) {
+                mi = 0xff; ma = 0;
+                for (int j=0; j<count; j++) {
+                    const GLsizei v = ((const GLubyte*)src)[j];
+                    if(v<mi) mi = v;
+                    if(v>ma) ma = v;
+                }
+            } else
+                minmax_indices(type, src, count, &ma, &mi);
+        }
+        if(mi<imin) imin = mi;
+        if(ma>imax) imax = ma;
+        ilen += (mode==GL_QUADS)?(count*3/2):count;
+        ++ranges;
+    }
+    if(!ranges)
+        return 0;
+    if(restart)
+        ilen += ranges-1;
+    // GLushort indices if possible (the restart index is the highest value of the type)
+    int useint = (imax >= (restart?0xffff:0x10000));
+    if(useint && !hardext.elementuint)
+        return 0;
+    const GLuint restartidx = useint?0xffffffffu:0xffffu;
+    GLushort *sind = NULL;
+    GLuint *iind = NULL;
+    if(useint)
+        iind = (GLuint*)malloc(ilen*sizeof(GLuint));
+    else
+        sind = (GLushort*)malloc(ilen*sizeof(GLushort));
+    // 2nd pass: fill the index list
+    GLsizei n = 0;
+    #define PUT(v) do { if(useint) iind[n++] = (v); else sind[n++] = (v); } while(0)
+    for (int i=0; i<primcount; i++) {
+        GLsizei count = adjust_vertices(mode, counts[i]);
+        if(!count)
+            continue;
+        if(restart && n)
+            PUT(restartidx);
+        const void *src = NULL;
+        if(!firsts)
+            src = (glstate->vao->elements)?((char*)glstate->vao->elements->data + (uintptr_t)indices[i]):indices[i];
+        #define GET(j) ((firsts)?(GLuint)(firsts[i]+(j)):(type==GL_UNSIGNED_INT)?((const GLuint*)src)[j]:(type==GL_UNSIGNED_SHORT)?((const GLushort*)src)[j]:((const GLubyte*)src)[j])
+        if(mode==GL_QUADS)
+            for (int j=0; j+3<count; j+=4) {
+                PUT(GET(j+0)); PUT(GET(j+1)); PUT(GET(j+2));
+                PUT(GET(j+0)); PUT(GET(j+2)); PUT(GET(j+3));
+            }
+        else
+            for (int j=0; j<count; j++)
+                PUT(GET(j));
+        #undef GET
+    }
+    #undef PUT
+    DBG(SHUT_LOGD("MultiDraw of %d ranges as 1 draw of %d indices (%s, restart=%d)\n", ranges, ilen, useint?"uint":"ushort", restart);)
+    LOAD_GLES(glEnable);
+    LOAD_GLES(glDisable);
+    GLuint old_index = wantBufferIndex(0);
+    if(restart)
+        gles_glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+    glDrawElementsCommon((mode==GL_QUADS)?GL_TRIANGLES:mode, imin, ilen, imax+1, sind, iind, 0, 1);
+    if(restart)
+        gles_glDisable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+    wantBufferIndex(old_index);
+    free(sind);
+    free(iind);
+    return 1;
+}
+
 #define MIN_BATCH  globals4es.minbatch
 #define MAX_BATCH  globals4es.maxbatch
 
@@ -470,6 +724,14 @@ void APIENTRY_GL4ES gl4es_glDrawRangeElements(GLenum mode, GLuint start, GLuint
     bool compiling = (glstate->list.active);
     bool intercept = should_intercept_render(mode);
 
+    // small draws merger
+    if(globals4es.drawmerge && !compiling) {
+        if(!intercept && drawmerge_add(mode, 0, count, type, indices)) {
+            noerrorShim();
+            return;
+        }
+        drawmerge_flush();
+    }
     //BATCH Mode
     if(!compiling) {
         if((!intercept && !glstate->list.pending && (count>=MIN_BATCH && count<=MAX_BATCH)) 
@@ -549,7 +811,9 @@ void APIENTRY_GL4ES gl4es_glDrawRangeElements(GLenum mode, GLuint start, GLuint
         
         return;
     } else {
-        glDrawElementsCommon(mode, 0, count, end+1, sindices, iindices, 1);
+        if(mode==GL_QUADS && !need_free && glDrawQuadsElements(type, indices, count, 1))
+            return;
+        glDrawElementsCommon(mode, start, count, end+1, sindices, iindices, 0, 1);
         if(need_free)
             free(sindices);
     }
@@ -576,6 +840,14 @@ void APIENTRY_GL4ES gl4es_glDrawElements(GLenum mode, GLsizei count, GLenum type
     bool compiling = (glstate->list.active);
     bool intercept = should_intercept_render(mode);
 
+    // small draws merger
+    if(globals4es.drawmerge && !compiling) {
+        if(!intercept && drawmerge_add(mode, 0, count, type, indices)) {
+            noerrorShim();
+            return;
+        }
+        drawmerge_flush();
+    }
     //BATCH Mode
     if(!compiling) {
         if((!intercept && !glstate->list.pending && (count>=MIN_BATCH && count<=MAX_BATCH)) 
@@ -657,7 +929,9 @@ void APIENTRY_GL4ES gl4es_glDrawElements(GLenum mode, GLsizei count, GLenum type
         free_renderlist(list);
         return;
     } else {
-        glDrawElementsCommon(mode, 0, count, 0, sindices, iindices, 1);
+        if(mode==GL_QUADS && !need_free && glDrawQuadsElements(type, indices, count, 1))
+            return;
+        glDrawElementsCommon(mode, 0, count, 0, sindices, iindices, 0, 1);
         if(need_free) {
             free(sindices);
             wantBufferIndex(old_index);
@@ -693,6 +967,12 @@ void APIENTRY_GL4ES gl4es_glDrawArrays(GLenum mode, GLint first, GLsizei count)
 	noerrorShim();
 
     bool intercept = should_intercept_render(mode);
+    // small draws merger
+    if(globals4es.drawmerge && !glstate->list.active) {
+        if(!intercept && drawmerge_add(mode, first, count, 0, NULL))
+            return;
+        drawmerge_flush();
+    }
     //BATCH Mode
     if (!glstate->list.compiling) {
         if((!intercept && !glstate->list.pending && (count>=MIN_BATCH && count<=MAX_BATCH)) 
@@ -733,37 +1013,11 @@ void APIENTRY_GL4ES gl4es_glDrawArrays(GLenum mode, GLint first, GLsizei count)
         free_renderlist(list);
     } else {
         if (mode==GL_QUADS) {
-            // TODO: move those static in glstate
-            static GLushort *indices = NULL;
-            static int indcnt = 0;
-            static int indfirst = 0;
-            int realfirst = ((first%4)==0)?0:first;
-            int realcount = count + (first-realfirst);
-            if((indcnt < realcount) || (indfirst!=realfirst)) {
-                if(indcnt < realcount) {
-                    indcnt = realcount;
-                    if (indices) free(indices);
-                    indices = (GLushort*)malloc(sizeof(GLushort)*(indcnt*3/2));
-                }
-                indfirst = realfirst;
-                GLushort *p = indices;
-                for (int i=0, j=indfirst; i+3<indcnt; i+=4, j+=4) {
-                        *(p++) = j + 0;
-                        *(p++) = j + 1;
-                        *(p++) = j + 2;
-
-                        *(p++) = j + 0;
-                        *(p++) = j + 2;
-                        *(p++) = j + 3;
-                }
-            }
-            GLuint old_buffer = wantBufferIndex(0);
-            glDrawElementsCommon(GL_TRIANGLES, 0, count*3/2, count, indices+(first-indfirst)*3/2, NULL, 1);
-            wantBufferIndex(old_buffer);
+            glDrawQuadsArrays(first, count, 1);
             return;
         }
 
-        glDrawElementsCommon(mode, first, count, count, NULL, NULL, 1);
+        glDrawElementsCommon(mode, first, count, count, NULL, NULL, 0, 1);
     }
 }
 AliasExport(void,glDrawArrays,,(GLenum mode, GLint first, GLsizei count));
@@ -772,6 +1026,7 @@ AliasExport(void,glDrawArrays,EXT,(GLenum mode, GLint first, GLsizei count));
 void APIENTRY_GL4ES gl4es_glMultiDrawArrays(GLenum mode, const GLint *firsts, const GLsizei *counts, GLsizei primcount)
 {
     DBG(SHUT_LOGD("glMultiDrawArrays(%s, %p, %p, %d), list=%p pending=%d\n", PrintEnum(mode), firsts, counts, primcount, glstate->list.active, glstate->list.pending);)
+    drawmerge_flush();
     if(!primcount) {
         noerrorShim();
         return;
@@ -796,6 +1051,10 @@ void APIENTRY_GL4ES gl4es_glMultiDrawArrays(GLenum mode, const GLint *firsts, co
             glstate->list.active = alloc_renderlist();
         }
     }
+    if(!compiling && !intercept && multidraw_single(mode, firsts, counts, 0, NULL, primcount)) {
+        noerrorShim();
+        return;
+    }
     renderlist_t *list = NULL;
 
     GLenum err = 0;
@@ -843,37 +1102,11 @@ void APIENTRY_GL4ES gl4es_glMultiDrawArrays(GLenum mode, const GLint *firsts, co
                 list = arrays_to_renderlist(NULL, mode, first, count+first);
         } else {
             if (mode==GL_QUADS) {
-                // TODO: move those static in glstate
-                static GLushort *indices = NULL;
-                static int indcnt = 0;
-                static int indfirst = 0;
-                int realfirst = ((first%4)==0)?0:first;
-                int realcount = count + (first-realfirst);
-                if((indcnt < realcount) || (indfirst!=realfirst)) {
-                    if(indcnt < realcount) {
-                        indcnt = realcount;
-                        if (indices) free(indices);
-                        indices = (GLushort*)malloc(sizeof(GLushort)*(indcnt*3/2));
-                    }
-                    indfirst = realfirst;
-                    GLushort *p = indices;
-                    for (int i=0, j=indfirst; i+3<indcnt; i+=4, j+=4) {
-                            *(p++) = j + 0;
-                            *(p++) = j + 1;
-                            *(p++) = j + 2;
-
-                            *(p++) = j + 0;
-                            *(p++) = j + 2;
-                            *(p++) = j + 3;
-                    }
-                }
-                GLuint old_index = wantBufferIndex(0);
-                glDrawElementsCommon(GL_TRIANGLES, 0, count*3/2, count, indices+(first-indfirst)*3/2, NULL, 1);
-                wantBufferIndex(old_index);
+                glDrawQuadsArrays(first, count, 1);
                 continue;
             }
 
-            glDrawElementsCommon(mode, first, count, count, NULL, NULL, 1);
+            glDrawElementsCommon(mode, first, count, count, NULL, NULL, 0, 1);
         }
     }
     if(list) {
@@ -891,6 +1124,7 @@ AliasExport(void,glMultiDrawArrays,,(GLenum mode, const GLint *first, const GLsi
 void APIENTRY_GL4ES gl4es_glMultiDrawElements( GLenum mode, GLsizei *counts, GLenum type, const void * const *indices, GLsizei primcount)
 {
     DBG(SHUT_LOGD("glMultiDrawElements(%s, %p, %s, %p, %d), list=%p pending=%d\n", PrintEnum(mode), counts, PrintEnum(type), indices, primcount, glstate->list.active, glstate->list.pending);)
+    drawmerge_flush();
     if (!primcount) {
         noerrorShim();
         return;
@@ -915,6 +1149,10 @@ void APIENTRY_GL4ES gl4es_glMultiDrawElements( GLenum mode, GLsizei *counts, GLe
             glstate->list.active = alloc_renderlist();
         }
     }
+    if (!compiling && !intercept && multidraw_single(mode, NULL, counts, type, indices, primcount)) {
+        noerrorShim();
+        return;
+    }
 
     renderlist_t* list = NULL;
     for (int i = 0; i < primcount; i++) {
@@ -1014,7 +1252,7 @@ void APIENTRY_GL4ES gl4es_glMultiDrawElements( GLenum mode, GLsizei *counts, GLe
             continue;
         }
         else {
-            glDrawElementsCommon(mode, 0, count, 0, sindices, iindices, 1);
+            glDrawElementsCommon(mode, 0, count, 0, sindices, iindices, 0, 1);
             if (need_free)
                 free(sindices);
         }
@@ -1029,6 +1267,7 @@ AliasExport(void,glMultiDrawElements,,( GLenum mode, GLsizei *count, GLenum type
 
 void APIENTRY_GL4ES gl4es_glMultiDrawElementsBaseVertex( GLenum mode, GLsizei *counts, GLenum type, const void * const *indices, GLsizei primcount, const GLint * basevertex) {
     DBG(SHUT_LOGD("glMultiDrawElementsBaseVertex(%s, %p, %s, @%p, %d, @%p), inlist=%i, pending=%d\n", PrintEnum(mode), counts, PrintEnum(type), indices, primcount, basevertex, (glstate->list.active)?1:0, glstate->list.pending);)
+    drawmerge_flush();
     LOAD_GLES2(glDrawElementsBaseVertex);
     scratch_t scratch = {0};
     realize_glenv(mode==GL_POINTS, 0, 0, type, indices, &scratch);
@@ -1053,6 +1292,7 @@ AliasExport(void,glMultiDrawElementsBaseVertex,ARB,( GLenum mode, GLsizei *count
 
 void APIENTRY_GL4ES gl4es_glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex) {
     DBG(SHUT_LOGD("glDrawElementsBaseVertex(%s, %d, %s, %p, %d), vtx=%p map=%p, pending=%d\n", PrintEnum(mode), count, PrintEnum(type), indices, basevertex, (glstate->vao->vertex)?glstate->vao->vertex->data:NULL, (glstate->vao->elements)?glstate->vao->elements->data:NULL, glstate->list.pending);)
+    drawmerge_flush();
 
     LOAD_GLES2(glDrawElementsBaseVertex);
     scratch_t scratch = {0};
@@ -1155,7 +1395,7 @@ void APIENTRY_GL4ES gl4es_glDrawRangeElementsBaseVertex(GLenum mode, GLuint star
             else
                 for(int i=0; i<count; i++) sindices[i]+=basevertex;
             GLuint old_index = wantBufferIndex(0);
-            glDrawElementsCommon(mode, 0, count, end+basevertex+1, sindices, iindices, 1);
+            glDrawElementsCommon(mode, start+basevertex, count, end+basevertex+1, sindices, iindices, 0, 1);
             if(iindices)
                 free(iindices);
             else
@@ -1169,6 +1409,7 @@ AliasExport(void,glDrawRangeElementsBaseVertex,ARB,(GLenum mode, GLuint start, G
 
 void APIENTRY_GL4ES gl4es_glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei primcount) {
     DBG(SHUT_LOGD("glDrawArraysInstanced(%s, %d, %d, %d), list=%p pending=%d\n", PrintEnum(mode), first, count, primcount, glstate->list.active, glstate->list.pending);)
+    drawmerge_flush();
     count = adjust_vertices(mode, count);
 
 	if (count<0) {
@@ -1228,37 +1469,11 @@ void APIENTRY_GL4ES gl4es_glDrawArraysInstanced(GLenum mode, GLint first, GLsize
         free_renderlist(list);
     } else {
         if (mode==GL_QUADS) {
-            // TODO: move those static in glstate
-            static GLushort *indices = NULL;
-            static int indcnt = 0;
-            static int indfirst = 0;
-            int realfirst = ((first%4)==0)?0:first;
-            int realcount = count + (first-realfirst);
-            if((indcnt < realcount) || (indfirst!=realfirst)) {
-                if(indcnt < realcount) {
-                    indcnt = realcount;
-                    if (indices) free(indices);
-                    indices = (GLushort*)malloc(sizeof(GLushort)*(indcnt*3/2));
-                }
-                indfirst = realfirst;
-                GLushort *p = indices;
-                for (int i=0, j=indfirst; i+3<indcnt; i+=4, j+=4) {
-                        *(p++) = j + 0;
-                        *(p++) = j + 1;
-                        *(p++) = j + 2;
-
-                        *(p++) = j + 0;
-                        *(p++) = j + 2;
-                        *(p++) = j + 3;
-                }
-            }
-            GLuint old_buffer = wantBufferIndex(0);
-            glDrawElementsCommon(GL_TRIANGLES, 0, count*3/2, count, indices+(first-indfirst)*3/2, NULL, primcount);
-            wantBufferIndex(old_buffer);
+            glDrawQuadsArrays(first, count, primcount);
             return;
         }
 
-        glDrawElementsCommon(mode, first, count, count, NULL, NULL, primcount);
+        glDrawElementsCommon(mode, first, count, count, NULL, NULL, 0, primcount);
     }
 }
 AliasExport(void,glDrawArraysInstanced,,(GLenum mode, GLint first, GLsizei count, GLsizei primcount));
@@ -1266,6 +1481,7 @@ AliasExport(void,glDrawArraysInstanced,ARB,(GLenum mode, GLint first, GLsizei co
 
 void APIENTRY_GL4ES gl4es_glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei primcount) {
     DBG(SHUT_LOGD("glDrawElementsInstanced(%s, %d, %s, %p, %d), list=%p pending=%d\n", PrintEnum(mode), count, PrintEnum(type), indices, primcount, glstate->list.active, glstate->list.pending);)
+    drawmerge_flush();
     count = adjust_vertices(mode, count);
     
     if (count<0) {
@@ -1359,7 +1575,9 @@ void APIENTRY_GL4ES gl4es_glDrawElementsInstanced(GLenum mode, GLsizei count, GL
         free_renderlist(list);
         return;
     } else {
-        glDrawElementsCommon(mode, 0, count, 0, sindices, iindices, primcount);
+        if(mode==GL_QUADS && !need_free && glDrawQuadsElements(type, indices, count, primcount))
+            return;
+        glDrawElementsCommon(mode, 0, count, 0, sindices, iindices, 0, primcount);
         if(need_free) {
             free(sindices);
             wantBufferIndex(old_index);
@@ -1456,7 +1674,7 @@ void APIENTRY_GL4ES gl4es_glDrawElementsInstancedBaseVertex(GLenum mode, GLsizei
             else
                 for(int i=0; i<count; i++) sindices[i]+=basevertex;
             GLuint old_index = wantBufferIndex(0);
-            glDrawElementsCommon(mode, 0, count, 0, sindices, iindices, primcount);
+            glDrawElementsCommon(mode, 0, count, 0, sindices, iindices, 0, primcount);
             if(iindices)
                 free(iindices);
             else
@@ -0,0 +1,236 @@
+#include "drawmerge.h"
+
+#include <string.h>
+
+#include "../glx/hardext.h"
+#include "counters.h"
+#include "enum_info.h"
+#include "gl4es.h"
+#include "glstate.h"
+#include "init.h"
+#include "wrap/gl4es.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+#define DRAWMERGE_CAPACITY  1024
+#define DRAWMERGE_MAXELEM   (4*sizeof(GLfloat))    // largest element: 4 components of 4 bytes (no GL_DOUBLE)
+
+// can the draw be merged: client arrays only, no instancing, and no conversion done by realize_glenv
+static int drawmerge_usable(GLenum mode) {
+    if(glstate->list.active || glstate->list.compiling || glstate->raster.bm_drawing)
+        return 0;
+    if(mode!=GL_POINTS && mode!=GL_LINES && mode!=GL_TRIANGLES && mode!=GL_QUADS)
+        return 0;
+    if(glstate->polygon_mode==GL_POINT || glstate->polygon_mode==GL_LINE)
+        return 0;
+    if(glstate->vao->elements)
+        return 0;
+    int any = 0;
+    for (int i=0; i<hardext.maxvattrib; i++) {
+        vertexattrib_t *w = &glstate->vao->vertexattrib[i];
+        if(!w->enabled)
+            continue;
+        if(w->buffer || w->real_buffer || w->divisor || !w->pointer || w->size==GL_BGRA || w->type==GL_DOUBLE)
+            return 0;
+        any = 1;
+    }
+    return any;
+}
+
+// is the current state the same as the pending run
+static int drawmerge_compatible(drawmerge_t *dm, GLenum mode) {
+    if(dm->mode!=mode || dm->vao!=glstate->vao)
+        return 0;
+    for (int i=0; i<hardext.maxvattrib; i++) {
+        vertexattrib_t *w = &glstate->vao->vertexattrib[i];
+        if(w->enabled != ((dm->arrays>>i)&1))
+            return 0;
+        if(w->enabled) {
+            vertexattrib_t *f = &dm->format[i];
+            if(w->size!=f->size || w->type!=f->type || w->normalized!=f->normalized || w->integer!=f->integer)
+                return 0;
+        }
+    }
+    return memcmp(dm->vavalue, glstate->vavalue, sizeof(dm->vavalue))==0;
+}
+
+static void drawmerge_start(drawmerge_t *dm, GLenum mode) {
+    dm->mode = mode;
+    dm->vao = glstate->vao;
+    dm->arrays = 0;
+    for (int i=0; i<hardext.maxvattrib; i++) {
+        vertexattrib_t *w = &glstate->vao->vertexattrib[i];
+        if(!w->enabled)
+            continue;
+        dm->arrays |= 1<<i;
+        dm->elem[i] = gl_sizeof(w->type)*w->size;
+        memcpy(&dm->format[i], w, sizeof(vertexattrib_t));
+        dm->format[i].stride = dm->elem[i];
+        dm->format[i].divisor = 0;
+    }
+    memcpy(dm->vavalue, glstate->vavalue, sizeof(dm->vavalue));
+}
+
+static void drawmerge_reserve(drawmerge_t *dm, int len, int ilen) {
+    if(dm->len+len>dm->cap) {
+        dm->cap = dm->len+len+DRAWMERGE_CAPACITY;
+        if(dm->cap>DRAWMERGE_MAXVERTICES)
+            dm->cap = DRAWMERGE_MAXVERTICES;
+        for (int i=0; i<MAX_VATTRIB; i++)
+            if(dm->data[i])
+                dm->data[i] = realloc(dm->data[i], dm->cap*DRAWMERGE_MAXELEM);
+    }
+    for (int i=0; i<MAX_VATTRIB; i++)
+        if(!dm->data[i] && ((dm->arrays>>i)&1))
+            dm->data[i] = malloc(dm->cap*DRAWMERGE_MAXELEM);
+    if(dm->ilen+ilen>dm->icap) {
+        dm->icap = dm->ilen+ilen+DRAWMERGE_CAPACITY;
+        dm->indices = (GLushort*)realloc(dm->indices, dm->icap*sizeof(GLushort));
+    }
+}
+
+int drawmerge_add(GLenum mode, GLint first, GLsizei count, GLenum type, const GLvoid *indices) {
+    drawmerge_t *dm = glstate->drawmerge;
+    if(dm && dm->flushing)
+        return 0;
+    if(!drawmerge_usable(mode)) {
+        drawmerge_flush();
+        return 0;
+    }
+    // vertex range used by the draw
+    GLsizei imin = first, imax = first+count-1;
+    if(indices) {
+        if(type!=GL_UNSIGNED_BYTE && type!=GL_UNSIGNED_SHORT && type!=GL_UNSIGNED_INT) {
+            drawmerge_flush();
+            return 0;
+        }
+        if(type==GL_UNSIGNED_BYTE) {
+            // minmax_indices only knows GLushort and GLuint indices
+            imin = 0xff; imax = 0;
+            for (int i=0; i<count; i++) {
+                const GLsizei v = ((const GLubyte*)indices)[i];
+                if(v<imin) imin = v;
+                if(v>imax) imax = v;
+            }
+        } else
+            minmax_indices(type, indices, count, &imax, &imin);
+    }
+    int len = imax-imin+1;
+    if(len>globals4es.drawmerge) {
+        drawmerge_flush();
+        return 0;
+    }
+    int ilen = (mode==GL_QUADS)?(count/4*6):count;
+    if(!dm)
+        dm = glstate->drawmerge = (drawmerge_t*)calloc(1, sizeof(drawmerge_t));
+    if(dm->draws && (!drawmerge_compatible(dm, (mode==GL_QUADS)?GL_TRIANGLES:mode) || dm->len+len>DRAWMERGE_MAXVERTICES))
+        drawmerge_flush();
+    if(!dm->draws)
+        drawmerge_start(dm, (mode==GL_QUADS)?GL_TRIANGLES:mode);
+    drawmerge_reserve(dm, len, ilen);
+    // copy the vertices
+    for (int i=0; i<hardext.maxvattrib; i++) {
+        if(!((dm->arrays>>i)&1))
+            continue;
+        vertexattrib_t *w = &glstate->vao->vertexattrib[i];
+        const int elem = dm->elem[i];
+        const int stride = (w->stride)?w->stride:elem;
+        const char *src = (const char*)w->pointer + imin*stride;
+        char *dst = (char*)dm->data[i] + dm->len*elem;
+        if(stride==elem)
+            memcpy(dst, src, len*elem);
+        else
+            for (int j=0; j<len; j++, src+=stride, dst+=elem)
+                memcpy(dst, src, elem);
+    }
+    // rebase the indices
+    GLushort *dst = dm->indices + dm->ilen;
+    const int base = dm->len - imin;
+    #define GO(A) \
+    if(mode==GL_QUADS) \
+        for (int i=0; i+3<count; i+=4, dst+=6) { \
+            dst[0] = A(i+0)+base; dst[1] = A(i+1)+base; dst[2] = A(i+2)+base; \
+            dst[3] = A(i+0)+base; dst[4] = A(i+2)+base; dst[5] = A(i+3)+base; \
+        } \
+    else \
+        for (int i=0; i<count; i++) \
+            dst[i] = A(i)+base
+    #define ARRAYS(i) (first+(i))
+    #define UBYTE(i) ((const GLubyte*)indices)[i]
+    #define USHORT(i) ((const GLushort*)indices)[i]
+    #define UINT(i) ((const GLuint*)indices)[i]
+    if(!indices) {
+        GO(ARRAYS);
+    } else if(type==GL_UNSIGNED_BYTE) {
+        GO(UBYTE);
+    } else if(type==GL_UNSIGNED_SHORT) {
+        GO(USHORT);
+    } else {
+        GO(UINT);
+    }
+    #undef UINT
+    #undef USHORT
+    #undef UBYTE
+    #undef ARRAYS
+    #undef GO
+    dm->len += len;
+    dm->ilen += ilen;
+    dm->draws++;
+    glstate->list.pending = 1;
+    DBG(SHUT_LOGD("drawmerge_add(%s, %d, %d, %s, %p) => %d draws, %d vertices, %d indices\n", PrintEnum(mode), first, count, PrintEnum(type), indices, dm->draws, dm->len, dm->ilen);)
+    return 1;
+}
+
+void drawmerge_flush() {
+    drawmerge_t *dm = glstate->drawmerge;
+    if(!dm || !dm->draws || dm->flushing)
+        return;
+    glstate->list.pending = 0;
+    // draw the run with the state it was built with: staging arrays in the VAO of the run, and the current values it started with
+    vertexattrib_t saved[MAX_VATTRIB];
+    GLfloat savedva[MAX_VATTRIB][4];
+    glvao_t *oldvao = glstate->vao;
+    glvao_t *vao = glstate->vao = dm->vao;
+    glbuffer_t *oldelements = vao->elements;
+    vao->elements = NULL;
+    memcpy(saved, vao->vertexattrib, sizeof(saved));
+    for (int i=0; i<hardext.maxvattrib; i++)
+        if((dm->arrays>>i)&1) {
+            memcpy(&vao->vertexattrib[i], &dm->format[i], sizeof(vertexattrib_t));
+            vao->vertexattrib[i].pointer = dm->data[i];
+        } else
+            vao->vertexattrib[i].enabled = 0;
+    int va = memcmp(dm->vavalue, glstate->vavalue, sizeof(savedva));
+    if(va) {
+        memcpy(savedva, glstate->vavalue, sizeof(savedva));
+        memcpy(glstate->vavalue, dm->vavalue, sizeof(savedva));
+    }
+    DBG(SHUT_LOGD("drawmerge_flush() %d draws, %d vertices, %d indices\n", dm->draws, dm->len, dm->ilen);)
+    COUNTER_INC(drawmerge_runs);
+    COUNTER_ADD(drawmerge_draws, dm->draws);
+    dm->flushing = 1;
+    gl4es_glDrawRangeElements(dm->mode, 0, dm->len-1, dm->ilen, GL_UNSIGNED_SHORT, dm->indices);
+    dm->flushing = 0;
+    if(va)
+        memcpy(glstate->vavalue, savedva, sizeof(savedva));
+    memcpy(vao->vertexattrib, saved, sizeof(saved));
+    vao->elements = oldelements;
+    glstate->vao = oldvao;
+    dm->draws = 0;
+    dm->len = 0;
+    dm->ilen = 0;
+}
+
+void drawmerge_free(drawmerge_t *dm) {
+    if(!dm)
+        return;
+    for (int i=0; i<MAX_VATTRIB; i++)
+        free(dm->data[i]);
+    free(dm->indices);
+    free(dm);
+}
@@ -0,0 +1,40 @@
+#ifndef _GL4ES_DRAWMERGE_H_
+#define _GL4ES_DRAWMERGE_H_
+
+#include "buffers.h"
+
+// Merger of consecutive small glDrawArrays / glDrawElements using client arrays (see LIBGL_DRAWMERGE)
+// Draws with the same primitive, the same arrays formats and the same current attributes are concatenated:
+// the vertices they use are copied in staging arrays and their indices are rebased on those,
+// so the whole run goes to the driver as 1 indexed draw. While a run is pending, glstate->list.pending is set
+// (without an active list), so the usual BATCH flush points (state changes, queries, read-back, swap) send it.
+
+#define DRAWMERGE_MAXVERTICES   65535   // merged indices are GLushort
+
+struct drawmerge_s {
+    GLenum          mode;       // GL_POINTS, GL_LINES or GL_TRIANGLES (GL_QUADS are merged as triangles)
+    glvao_t         *vao;       // VAO of the run
+    GLuint          arrays;     // enabled attributes of the run (1 bit per attribute)
+    vertexattrib_t  format[MAX_VATTRIB];    // format of each enabled attribute (pointer is the staging array)
+    int             elem[MAX_VATTRIB];      // size in bytes of 1 element of each enabled attribute
+    GLfloat         vavalue[MAX_VATTRIB][4];// current value of the attributes when the run started
+    void            *data[MAX_VATTRIB];     // staging arrays
+    int             len;        // vertices in the staging arrays
+    int             cap;        // capacity of the staging arrays, in vertices
+    GLushort        *indices;
+    int             ilen;
+    int             icap;
+    int             draws;      // draws merged in the run
+    int             flushing;   // the run is being drawn
+};
+typedef struct drawmerge_s drawmerge_t;
+
+// add a draw to the pending run (indices is NULL for glDrawArrays, else client indices of type "type")
+// return 0 if the draw cannot be merged: it has to be done the normal way (any pending run has been sent)
+int drawmerge_add(GLenum mode, GLint first, GLsizei count, GLenum type, const GLvoid *indices);
+// send the pending run, if any
+void drawmerge_flush();
+// free the merger of a glstate
+void drawmerge_free(drawmerge_t *dm);
+
+#endif // _GL4ES_DRAWMERGE_H_
@@ -138,7 +138,7 @@ static void proxy_glEnable(GLenum cap, bool enable, void (APIENTRY_GLES *next)(G
         proxy_GOFPE(GL_LIGHT7, light[7], fpe_changelight(7, enable));
         proxy_GOFPE(GL_LIGHTING, lighting, glstate->fpe_state->lighting=enable);
         proxy_GOFPE(GL_NORMALIZE, normalize, glstate->fpe_state->normalize=enable);
-        proxy_GOFPE(GL_RESCALE_NORMAL, normal_rescale, glstate->fpe_state->rescaling=enable);
+        proxy_GOFPE(GL_RESCALE_NORMAL, normal_rescale, glstate->fpe_state->rescaling=enable; DIRTY_UNIFORMS(UG_MODELVIEW));
         proxy_GOFPE(GL_COLOR_MATERIAL, color_material, glstate->fpe_state->color_material=enable);
 
         // point sprite
@@ -1,8 +1,10 @@
 #include "../glx/hardext.h"
 #include "array.h"
+#include "counters.h"
 #include "debug.h"
 #include "enum_info.h"
 #include "fpe_shader.h"
+#include "fpe_ubo.h"
 #include "glcase.h"
 #include "init.h"
 #include "gl4es.h"
@@ -11,6 +13,7 @@
 #include "matvec.h"
 #include "program.h"
 #include "shaderconv.h"
+#include "tracer.h"
 
 #include "fpe.h"
 
@@ -36,6 +39,8 @@
 #define DBG(a)
 #endif
 
+unsigned int fpe_uniform_serial = 0;
+
 void free_scratch(scratch_t* scratch) {
     for(int i=0; i<scratch->size; ++i)
         free(scratch->scratch[i]);
@@ -385,8 +390,11 @@ void APIENTRY_GL4ES fpe_program(int ispoint) {
     if(glstate->fpe==NULL || memcmp(&glstate->fpe->state, &state, sizeof(fpe_state_t))) {
         // get cached fpe (or new one)
         glstate->fpe = fpe_GetCache(glstate->fpe_cache, &state, 1);
+        COUNTER_INC(fpe_switches);
     }   
     if(glstate->fpe->glprogram==NULL) {
+        COUNTER_INC(fpe_misses);
+        TRACE_BEGIN(trace_t0);
         glstate->fpe->prog = gl4es_glCreateProgram();
         DBG(int from_psa = 1;)
         if(fpe_GetProgramPSA(glstate->fpe->prog, &state)==0) {
@@ -448,6 +456,7 @@ void APIENTRY_GL4ES fpe_program(int ispoint) {
                 glstate->fpe->glprogram = kh_value(programs, k_program);
         }
         // all done
+        TRACE_END(trace_t0, "fpe_program", 0);
         DBG(SHUT_LOGD("%s FPE shader : %d(%p)\n", from_psa?"Using Precomp":"Creating", glstate->fpe->prog, glstate->fpe->glprogram);)
     }
 }
@@ -606,51 +615,76 @@ program_t* APIENTRY_GL4ES fpe_CustomShader_DefaultVertex(program_t* glprogram, f
     return fpe->glprogram;
 }
 
-void APIENTRY_GL4ES fpe_SyncUniforms(uniformcache_t *cache, program_t* glprogram) {
-    //TODO: Optimize this...
+static void fpe_BuildSyncUniforms(program_t *parent, program_t* glprogram) {
     khash_t(uniformlist) *uniforms = glprogram->uniform;
-    uniform_t *m;
+    uniform_t *m, *n;
     khint_t k;
-    DBG(int cnt = 0;)
-    // don't use m->size, as each element has it's own uniform...
+    free(glprogram->parent_sync);
+    glprogram->parent_sync = (uniform_sync_t*)malloc(sizeof(uniform_sync_t)*kh_size(uniforms));
+    glprogram->parent_sync_size = 0;
     kh_foreach(uniforms, k, m,
-        if(m->parent_size) {
-            DBG(++cnt;)
-            switch(m->type) {
-                case GL_FLOAT:
-                case GL_FLOAT_VEC2:
-                case GL_FLOAT_VEC3:
-                case GL_FLOAT_VEC4:
-                    GoUniformfv(glprogram, m->id, n_uniform(m->type), 1, (GLfloat*)((uintptr_t)cache->cache+m->parent_offs));
-                    break;
-                case GL_SAMPLER_2D:
-                case GL_SAMPLER_CUBE:
-                case GL_SAMPLER_2D_SHADOW:
-                case GL_INT:
-                case GL_INT_VEC2:
-                case GL_INT_VEC3:
-                case GL_INT_VEC4:
-                case GL_BOOL:
-                case GL_BOOL_VEC2:
-                case GL_BOOL_VEC3:
-                case GL_BOOL_VEC4:
-                    GoUniformiv(glprogram, m->id, n_uniform(m->type), 1, (GLint*)((uintptr_t)cache->cache+m->parent_offs));
-                    break;
-                case GL_FLOAT_MAT2:
-                    GoUniformMatrix2fv(glprogram, m->id, 1, false, (GLfloat*)((uintptr_t)cache->cache+m->parent_offs));
-                    break;
-                case GL_FLOAT_MAT3:
-                    GoUniformMatrix3fv(glprogram, m->id, 1, false, (GLfloat*)((uintptr_t)cache->cache+m->parent_offs));
-                    break;
-                case GL_FLOAT_MAT4:
-                    GoUniformMatrix4fv(glprogram, m->id, 1, false, (GLfloat*)((uintptr_t)cache->cache+m->parent_offs));
-                    break;
-                default:
-                    SHUT_LOGD("LIBGL: Warning, sync uniform on father/son program with unknown uniform type %s\n", PrintEnum(m->type));
-            }
+        if(m->parent_size && (n = findUniform(parent->uniform, m->name))) {
+            // the parent may have been relinked since the custom program was created
+            m->parent_offs = n->cache_offs;
+            m->parent_size = n->cache_size;
+            glprogram->parent_sync[glprogram->parent_sync_size].uniform = m;
+            glprogram->parent_sync[glprogram->parent_sync_size].parent = n;
+            ++glprogram->parent_sync_size;
         }
     );
-    DBG(SHUT_LOGD("Uniform sync'd with %d and father (%d uniforms)\n", glprogram->id, cnt);)
+    glprogram->parent_link = parent->link_gen;
+    glprogram->parent_gen = 0;  // full synchronization
+}
+
+void APIENTRY_GL4ES fpe_SyncUniforms(program_t *parent, program_t* glprogram) {
+    if(glprogram->parent_link != parent->link_gen)
+        fpe_BuildSyncUniforms(parent, glprogram);
+    // nothing written in the parent since last sync
+    if(glprogram->parent_gen == parent->uniform_gen)
+        return;
+    void* cache = parent->cache.cache;
+    DBG(int cnt = 0;)
+    // don't use m->size, as each element has it's own uniform...
+    for (int i=0; i<glprogram->parent_sync_size; ++i) {
+        uniform_t *m = glprogram->parent_sync[i].uniform;
+        if(glprogram->parent_gen && glprogram->parent_sync[i].parent->gen <= glprogram->parent_gen)
+            continue;   // not changed in the parent since last sync
+        DBG(++cnt;)
+        switch(m->type) {
+            case GL_FLOAT:
+            case GL_FLOAT_VEC2:
+            case GL_FLOAT_VEC3:
+            case GL_FLOAT_VEC4:
+                GoUniformfv(glprogram, m->id, n_uniform(m->type), 1, (GLfloat*)((uintptr_t)cache+m->parent_offs));
+                break;
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_2D_SHADOW:
+            case GL_INT:
+            case GL_INT_VEC2:
+            case GL_INT_VEC3:
+            case GL_INT_VEC4:
+            case GL_BOOL:
+            case GL_BOOL_VEC2:
+            case GL_BOOL_VEC3:
+            case GL_BOOL_VEC4:
+                GoUniformiv(glprogram, m->id, n_uniform(m->type), 1, (GLint*)((uintptr_t)cache+m->parent_offs));
+                break;
+            case GL_FLOAT_MAT2:
+                GoUniformMatrix2fv(glprogram, m->id, 1, false, (GLfloat*)((uintptr_t)cache+m->parent_offs));
+                break;
+            case GL_FLOAT_MAT3:
+                GoUniformMatrix3fv(glprogram, m->id, 1, false, (GLfloat*)((uintptr_t)cache+m->parent_offs));
+                break;
+            case GL_FLOAT_MAT4:
+                GoUniformMatrix4fv(glprogram, m->id, 1, false, (GLfloat*)((uintptr_t)cache+m->parent_offs));
+                break;
+            default:
+                SHUT_LOGD("LIBGL: Warning, sync uniform on father/son program with unknown uniform type %s\n", PrintEnum(m->type));
+        }
+    }
+    glprogram->parent_gen = parent->uniform_gen;
+    DBG(SHUT_LOGD("Uniform sync'd with %d and father (%d/%d uniforms)\n", glprogram->id, cnt, glprogram->parent_sync_size);)
 }
 // ********* Fixed Pipeling function wrapper *********
 
@@ -837,16 +871,46 @@ void APIENTRY_GL4ES fpe_glDrawElements(GLenum mode, GLsizei count, GLenum type,
         wantBufferIndex(0);
     free_scratch(&scratch);
 }
+// the divisor of that attribute can be done by the hardware (the array doesn't need a conversion)
+#define HW_DIVISOR(w) ((w)->size!=GL_BGRA && (w)->type!=GL_DOUBLE)
+
+// can an instanced draw with this program be a single hardware draw (ES3), or does it need one draw per instance
+static int fpe_hwinstancing(program_t *glprogram) {
+    if(hardext.esversion<3)
+        return 0;
+    // _gl4es_InstanceID (shaders converted to GLSL ES 1.00) is a uniform, that can only change between draws
+    // GLSL ES 3.00 shaders use gl_InstanceID plus _gl4es_InstanceBase, so they also work with the per instance loop
+    if(glprogram->builtin_instanceID!=-1)
+        return 0;
+    for(int i=0; i<hardext.maxvattrib; i++)
+        if(glprogram->va_size[i]) {
+            vertexattrib_t *w = &glstate->vao->vertexattrib[i];
+            if(w->divisor && w->enabled && !HW_DIVISOR(w))
+                return 0;
+        }
+    return 1;
+}
+
 void APIENTRY_GL4ES fpe_glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei primcount) {
     DBG(SHUT_LOGD("fpe_glDrawArraysInstanced(%s, %d, %d, %d), program=%d\n", PrintEnum(mode), first, count, primcount, glstate->glsl->program);)
     LOAD_GLES(glDrawArrays);
     LOAD_GLES2(glVertexAttrib4fv);
+    LOAD_GLES3(glDrawArraysInstanced);
+    const GLint zero = 0;
     scratch_t scratch = {0};
     GLfloat tmp[4] = {0.0f, 0.0f, 0.0f, 1.0f};
     realize_glenv(mode==GL_POINTS, first, count, 0, NULL, &scratch);
     program_t *glprogram = glstate->gleshard->glprogram;
+    if(gles_glDrawArraysInstanced && fpe_hwinstancing(glprogram)) {
+        // divisor arrays are already setup by realize_glenv
+        GoUniformiv(glprogram, glprogram->builtin_instanceBase, 1, 1, &zero);
+        gles_glDrawArraysInstanced(mode, first, count, primcount);
+        free_scratch(&scratch);
+        return;
+    }
     for (GLint id=0; id<primcount; ++id) {
         GoUniformiv(glprogram, glprogram->builtin_instanceID, 1, 1, &id);
+        GoUniformiv(glprogram, glprogram->builtin_instanceBase, 1, 1, &id);
         for(int i=0; i<hardext.maxvattrib; i++) 
         if(glprogram->va_size[i])   // only check used VA...
         {
@@ -891,6 +955,8 @@ void APIENTRY_GL4ES fpe_glDrawElementsInstanced(GLenum mode, GLsizei count, GLen
     DBG(SHUT_LOGD("fpe_glDrawElementsInstanced(%s, %d, %s, %p, %d), program=%d\n", PrintEnum(mode), count, PrintEnum(type), indices, primcount, glstate->glsl->program);)
     LOAD_GLES(glDrawElements);
     LOAD_GLES2(glVertexAttrib4fv);
+    LOAD_GLES3(glDrawElementsInstanced);
+    const GLint zero = 0;
     scratch_t scratch = {0};
     realize_glenv(mode==GL_POINTS, 0, count, type, indices, &scratch);
     program_t *glprogram = glstate->gleshard->glprogram;
@@ -903,11 +969,19 @@ void APIENTRY_GL4ES fpe_glDrawElementsInstanced(GLenum mode, GLsizei count, GLen
         inds = (void*)((uintptr_t)indices - (uintptr_t)(glstate->vao->elements->data));
     } else {
         inds = (void*)indices;
-        bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        realize_bufferIndex();  // indices can also be in a VBO already binded (from a display list)
+    }
+    if(gles_glDrawElementsInstanced && fpe_hwinstancing(glprogram)) {
+        GoUniformiv(glprogram, glprogram->builtin_instanceBase, 1, 1, &zero);
+        gles_glDrawElementsInstanced(mode, count, type, inds, primcount);
+        if(use_vbo)
+            wantBufferIndex(0);
+        free_scratch(&scratch);
+        return;
     }
-    //realize_bufferIndex();    // not useful here
     for (GLint id=0; id<primcount; ++id) {
         GoUniformiv(glprogram, glprogram->builtin_instanceID, 1, 1, &id);
+        GoUniformiv(glprogram, glprogram->builtin_instanceBase, 1, 1, &id);
         for(int i=0; i<hardext.maxvattrib; i++) 
         if(glprogram->va_size[i])   // only check used VA...
         {
@@ -1057,6 +1131,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
     LOAD_GLES2(glVertexAttribIPointer);
     LOAD_GLES2(glVertexAttrib4fv);
     LOAD_GLES2(glUseProgram);
+    LOAD_GLES3(glVertexAttribDivisor);
     // update texture state for fpe only
     if(glstate->fpe_bound_changed && !glstate->glsl->program) {
         for(int i=0; i<glstate->fpe_bound_changed; i++) {
@@ -1120,7 +1195,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         }
         // synchronize uniforms with parent!
         if(glprogram != glstate->glsl->glprogram)
-            fpe_SyncUniforms(&glstate->glsl->glprogram->cache, glprogram);
+            fpe_SyncUniforms(glstate->glsl->glprogram, glprogram);
     } else {
         fpe_program(ispoint);
         if(glstate->gleshard->program != glstate->fpe->prog)
@@ -1164,23 +1239,33 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
             //gles_glFramebufferTexture2D(GL_FRAMEBUFFER, tex->binded_attachment, GL_TEXTURE_2D, tex->glname, 0);
         }
     }
+    // builtin uniforms groups that changed since this program last sent them
+    unsigned int changed = 0;
+    for (int i=0; i<UG_MAX; i++)
+        if(glprogram->builtin_gen[i]!=glstate->uniform_gen[i]) {
+            glprogram->builtin_gen[i] = glstate->uniform_gen[i];
+            changed |= 1<<i;
+        }
+    #define CHANGED(A) (changed&(1<<UG_##A))
+    // the builtins in the shared uniform block are uploaded once for all programs
+    if(glprogram->has_fpe_ubo)
+        fpe_ubo_update();
     // setup fixed pipeline builtin matrix uniform if needed
-    if(glprogram->has_builtin_matrix)
+    if(glprogram->has_builtin_matrix && (CHANGED(MODELVIEW) || CHANGED(PROJECTION) || CHANGED(TEXMATRIX)))
     {
-        if(glprogram->builtin_matrix[MAT_MVP]!=-1 || glprogram->builtin_matrix[MAT_MVP_I]!=-1
-            || glprogram->builtin_matrix[MAT_MVP_T]!=-1 || glprogram->builtin_matrix[MAT_MVP_IT]!=-1)
+        if((CHANGED(MODELVIEW) || CHANGED(PROJECTION)) && (glprogram->builtin_matrix[MAT_MVP]!=-1 || glprogram->builtin_matrix[MAT_MVP_I]!=-1
+            || glprogram->builtin_matrix[MAT_MVP_T]!=-1 || glprogram->builtin_matrix[MAT_MVP_IT]!=-1))
         {
             GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP], 1, GL_FALSE, getMVPMat());
             GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP_T], 1, GL_TRUE, getMVPMat());
             if(glprogram->builtin_matrix[MAT_MVP_I]!=-1 || glprogram->builtin_matrix[MAT_MVP_IT]!=-1) {
-                GLfloat invmat[16];
-                matrix_inverse(getMVPMat(), invmat);
+                const GLfloat *invmat = getInvMVPMat();
                 GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP_I], 1, GL_FALSE, invmat);
                 GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MVP_IT], 1, GL_TRUE, invmat);
             }
         }
-        if(glprogram->builtin_matrix[MAT_MV]!=-1 || glprogram->builtin_matrix[MAT_MV_I]!=-1
-            || glprogram->builtin_matrix[MAT_MV_T]!=-1 || glprogram->builtin_matrix[MAT_MV_IT]!=-1)
+        if(CHANGED(MODELVIEW) && (glprogram->builtin_matrix[MAT_MV]!=-1 || glprogram->builtin_matrix[MAT_MV_I]!=-1
+            || glprogram->builtin_matrix[MAT_MV_T]!=-1 || glprogram->builtin_matrix[MAT_MV_IT]!=-1))
         {
             GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV], 1, GL_FALSE, getMVMat());
             GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV_T], 1, GL_TRUE, getMVMat());
@@ -1189,20 +1274,19 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
                 GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_MV_IT], 1, GL_TRUE, getInvMVMat());
             }
         }
-        if(glprogram->builtin_matrix[MAT_P]!=-1 || glprogram->builtin_matrix[MAT_P_I]!=-1
-            || glprogram->builtin_matrix[MAT_P_T]!=-1 || glprogram->builtin_matrix[MAT_P_IT]!=-1)
+        if(CHANGED(PROJECTION) && (glprogram->builtin_matrix[MAT_P]!=-1 || glprogram->builtin_matrix[MAT_P_I]!=-1
+            || glprogram->builtin_matrix[MAT_P_T]!=-1 || glprogram->builtin_matrix[MAT_P_IT]!=-1))
         {
             GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P], 1, GL_FALSE, getPMat());
             GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P_T], 1, GL_TRUE, getPMat());
             if(glprogram->builtin_matrix[MAT_P_I]!=-1 || glprogram->builtin_matrix[MAT_P_IT]!=-1) {
-                GLfloat invmat[16];
-                matrix_inverse(getPMat(), invmat);
+                const GLfloat *invmat = getInvPMat();
                 GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P_I], 1, GL_FALSE, invmat);
                 GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_P_IT], 1, GL_TRUE, invmat);
             }
         }
         //Normal matrix (mat3 version of transpose(inverse(gl_ModelViewMatrix)))
-        if(glprogram->builtin_matrix[MAT_N]!=-1 || glprogram->builtin_normalrescale!=-1)
+        if(CHANGED(MODELVIEW) && (glprogram->builtin_matrix[MAT_N]!=-1 || glprogram->builtin_normalrescale!=-1))
         {
             if(glprogram->builtin_normalrescale!=-1 && !glstate->fpe_state->rescaling)
             {
@@ -1223,6 +1307,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
             }
         }
         //Texture matrices
+        if(CHANGED(TEXMATRIX))
         for (int i=0; i<MAX_TEX; i++) {
             if(glprogram->builtin_matrix[MAT_T0+i*4]!=-1 || glprogram->builtin_matrix[MAT_T0_I+i*4]!=-1
                 || glprogram->builtin_matrix[MAT_T0_T+i*4]!=-1 || glprogram->builtin_matrix[MAT_T0_IT+i*4]!=-1)
@@ -1230,8 +1315,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
                 GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_T0+i*4], 1, GL_FALSE, getTexMat(i));
                 GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_T0_T+i*4], 1, GL_TRUE, getTexMat(i));
                 if(glprogram->builtin_matrix[MAT_T0_I+i*4]!=-1 || glprogram->builtin_matrix[MAT_T0_IT+i*4]!=-1) {
-                    GLfloat invmat[16];
-                    matrix_inverse(getTexMat(i), invmat);
+                    const GLfloat *invmat = getInvTexMat(i);
                     GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_T0_I+i*4], 1, GL_FALSE, invmat);
                     GoUniformMatrix4fv(glprogram, glprogram->builtin_matrix[MAT_T0_IT+i*4], 1, GL_TRUE, invmat);
                 }
@@ -1239,10 +1323,10 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         }
     }
     // set light and material if needed
-    if(glprogram->has_builtin_light)
+    if(glprogram->has_builtin_light && (CHANGED(LIGHT) || CHANGED(MATERIAL)))
     {
         for (int i=0; i<MAX_LIGHT; i++) {
-            if(glprogram->builtin_lights[i].has) {
+            if(CHANGED(LIGHT) && glprogram->builtin_lights[i].has) {
                GoUniformfv(glprogram, glprogram->builtin_lights[i].ambient, 4, 1, glstate->light.lights[i].ambient);
                GoUniformfv(glprogram, glprogram->builtin_lights[i].diffuse, 4, 1, glstate->light.lights[i].diffuse);
                GoUniformfv(glprogram, glprogram->builtin_lights[i].specular, 4, 1, glstate->light.lights[i].specular);
@@ -1289,10 +1373,10 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
                 GoUniformfv(glprogram, glprogram->builtin_lightprod[1][i].specular, 4, 1, tmp);
             }
         }
-        if(glprogram->builtin_lightmodel.ambient!=-1) {
+        if(CHANGED(LIGHT) && glprogram->builtin_lightmodel.ambient!=-1) {
             GoUniformfv(glprogram, glprogram->builtin_lightmodel.ambient, 4, 1, glstate->light.ambient);
         }
-        if(glprogram->builtin_material[0].has) {
+        if(CHANGED(MATERIAL) && glprogram->builtin_material[0].has) {
             GoUniformfv(glprogram, glprogram->builtin_material[0].emission, 4, 1, glstate->material.front.emission);
             GoUniformfv(glprogram, glprogram->builtin_material[0].ambient, 4, 1, glstate->material.front.ambient);
             GoUniformfv(glprogram, glprogram->builtin_material[0].diffuse, 4, 1, glstate->material.front.diffuse);
@@ -1300,7 +1384,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
             GoUniformfv(glprogram, glprogram->builtin_material[0].shininess, 1, 1, &glstate->material.front.shininess);
             GoUniformfv(glprogram, glprogram->builtin_material[0].alpha, 1, 1, &glstate->material.front.diffuse[3]);
         }
-        if(glprogram->builtin_material[1].has) {
+        if(CHANGED(MATERIAL) && glprogram->builtin_material[1].has) {
             GoUniformfv(glprogram, glprogram->builtin_material[1].emission, 4, 1, glstate->material.back.emission);
             GoUniformfv(glprogram, glprogram->builtin_material[1].ambient, 4, 1, glstate->material.back.ambient);
             GoUniformfv(glprogram, glprogram->builtin_material[1].diffuse, 4, 1, glstate->material.back.diffuse);
@@ -1326,8 +1410,12 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
     {
         GoUniformiv(glprogram, glprogram->builtin_instanceID, 1, 1, &glstate->instanceID);
     }
+    if(glprogram->builtin_instanceBase!=-1)
+    {
+        GoUniformiv(glprogram, glprogram->builtin_instanceBase, 1, 1, &glstate->instanceID);
+    }
     // fog parameters
-    if(glprogram->builtin_fog.has)
+    if(CHANGED(FOG) && glprogram->builtin_fog.has)
     {
         GoUniformfv(glprogram, glprogram->builtin_fog.color, 4, 1, glstate->fog.color);
         GoUniformfv(glprogram, glprogram->builtin_fog.density, 1, 1, &glstate->fog.density);
@@ -1339,14 +1427,14 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         }
     }
     // clip planes
-    if(glprogram->has_builtin_clipplanes)
+    if(CHANGED(CLIPPLANES) && glprogram->has_builtin_clipplanes)
     {
         for (int i=0; i<hardext.maxplanes; i++) {
             GoUniformfv(glprogram, glprogram->builtin_clipplanes[i], 4, 1, glstate->planes[i]);
         }
     }
     // check point sprite if needed
-    if(glprogram->builtin_pointsprite.has)
+    if(CHANGED(POINTSPRITE) && glprogram->builtin_pointsprite.has)
     {
         GoUniformfv(glprogram, glprogram->builtin_pointsprite.size, 1, 1, &glstate->pointsprite.size);
         GoUniformfv(glprogram, glprogram->builtin_pointsprite.sizeMin, 1, 1, &glstate->pointsprite.sizeMin);
@@ -1357,7 +1445,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         GoUniformfv(glprogram, glprogram->builtin_pointsprite.distanceQuadraticAttenuation, 1, 1, glstate->pointsprite.distance+2);
     }
     // texenv
-    if(glprogram->has_builtin_texenv)
+    if(CHANGED(TEXENV) && glprogram->has_builtin_texenv)
     {
         for (int i=0; i<hardext.maxtex; i++) {
             GoUniformfv(glprogram, glprogram->builtin_texenvcolor[i], 4, 1, glstate->texenv[i].env.color);
@@ -1367,7 +1455,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         }
     }
     // texgen
-    if(glprogram->has_builtin_texgen)
+    if(CHANGED(TEXGEN) && glprogram->has_builtin_texgen)
     {
         for (int i=0; i<hardext.maxtex; i++) {
             GoUniformfv(glprogram, glprogram->builtin_eye[0][i], 4, 1, glstate->texgen[i].S_E);
@@ -1401,7 +1489,7 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         }
     }
     // oldprograms
-    if(glprogram->last_vert && glprogram->last_vert->old) {
+    if(CHANGED(PROGPARAMS) && glprogram->last_vert && glprogram->last_vert->old) {
         if(glprogram->has_vtx_progenv) {
             for (int i=0; i<MAX_VTX_PROG_ENV_PARAMS; ++i)
                 GoUniformfv(glprogram, glprogram->vtx_progenv[i], 4, 1, glstate->glsl->vtx_env_params+i*4);
@@ -1412,11 +1500,11 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         }
     }
     if(glprogram->last_frag && glprogram->last_frag->old) {
-        if(glprogram->has_frg_progenv) {
+        if(CHANGED(PROGPARAMS) && glprogram->has_frg_progenv) {
             for (int i=0; i<MAX_FRG_PROG_ENV_PARAMS; ++i)
                 GoUniformfv(glprogram, glprogram->frg_progenv[i], 4, 1, glstate->glsl->frg_env_params+i*4);
         }
-        if(glprogram->has_frg_progloc) {
+        if(CHANGED(PROGPARAMS) && glprogram->has_frg_progloc) {
             for (int i=0; i<MAX_FRG_PROG_LOC_PARAMS; ++i)
                 GoUniformfv(glprogram, glprogram->frg_progloc[i], 4, 1, glprogram->last_frag->old->prog_local_params+i*4);
         }
@@ -1431,7 +1519,28 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         GO(Cube)
         #undef GO
     }
+    #undef CHANGED
     // set VertexAttrib if needed
+    // with hardware instancing, attributes with a divisor are arrays, else they are a single value changed for each instance
+    int hwinstancing = gles_glVertexAttribDivisor && fpe_hwinstancing(glprogram);
+    // on ES3, each VAO has its own native vertex arrays, so the attributes are usually already set there
+    // but client side arrays and indices are only allowed in the default one
+    glvao_t *hardvao = NULL;
+    if(hardext.esversion>2 && !globals4es.nohardvao) {
+        hardvao = glstate->vao;
+        if(type && !glstate->bind_buffer.want_index) {
+            glbuffer_t *e = glstate->vao->elements;
+            if(!e || !e->real_buffer || indices<e->data || indices>(void*)((char*)e->data+e->size))
+                hardvao = NULL;
+        }
+        for(int i=0; i<hardext.maxvattrib && hardvao; i++)
+        if(glprogram->va_size[i]) {
+            vertexattrib_t *w = &glstate->vao->vertexattrib[i];
+            if(w->enabled && (w->buffer || w->pointer) && !(w->divisor && !hwinstancing) && (!w->real_buffer || !HW_DIVISOR(w)))
+                hardvao = NULL;
+        }
+    }
+    realize_hardvao(hardvao, glprogram->va_used);
     for(int i=0; i<hardext.maxvattrib; i++) 
     if(glprogram->va_size[i])   // only check used VA...
     {
@@ -1439,14 +1548,15 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
         vertexattrib_t *w = &glstate->vao->vertexattrib[i];
         int enabled = w->enabled;
         int dirty = 0;
+        int softdivisor = w->divisor && !hwinstancing;
         if(enabled && !w->buffer && !w->pointer) {
             DBG(SHUT_LOGD("Warning: VA %d Enabled with buffer:0 and NULL pointer, disabling\n", i));
             enabled = 0;
         }
         // enable / disable Array if needed
-        if(v->enabled != enabled || (v->enabled && w->divisor)) {
+        if(v->enabled != enabled || (v->enabled && softdivisor)) {
             dirty = 1;
-            v->enabled = (w->divisor)?0:enabled;
+            v->enabled = (softdivisor)?0:enabled;
             DBG(SHUT_LOGD("VertexAttribArray[%d]:%s, divisor=%d\n", i, (enabled)?"Enable":"Disable", w->divisor);)
             if(v->enabled)
                 gles_glEnableVertexAttribArray(i);
@@ -1460,17 +1570,14 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
             if(dirty || v->size!=w->size || v->type!=w->type || v->normalized!=w->normalized 
                 || v->stride!=w->stride || v->buffer!=w->buffer || (w->real_buffer==0 && v->pointer!=ptr)
                 || v->real_buffer!=w->real_buffer || (w->real_buffer!=0 && v->real_pointer != w->real_pointer) 
-                || w->real_buffer!=glstate->bind_buffer.array) {
+                || (!hardvao && w->real_buffer!=glstate->bind_buffer.array)) {
                 if((w->size==GL_BGRA || w->type==GL_DOUBLE) && scratch->size<8) { 
                     // need to adjust, so first need the min/max (a shame as I already must have that somewhere)
                     int imin, imax;
                     if(type==0) {
                         imin = first; imax = count;
                     } else {
-                        if(type==GL_UNSIGNED_INT)
-                            getminmax_indices_ui(indices, &imax, &imin, count);
-                        else
-                            getminmax_indices_us(indices, &imax, &imin, count);
+                        minmax_indices(type, indices, count, &imax, &imin);
                         ++imax;
                     }
                     if(w->size==GL_BGRA) {
@@ -1517,6 +1624,11 @@ void realize_glenv(int ispoint, int first, int count, GLenum type, const void* i
                     DBG(SHUT_LOGD("glVertexAttribPointer(%d, %d, %s, %d, %d, %p)\n", i, v->size, PrintEnum(v->type), v->normalized, v->stride, v->pointer);)
                 }
             }
+            if(gles_glVertexAttribDivisor && v->divisor!=w->divisor) {
+                v->divisor = w->divisor;
+                gles_glVertexAttribDivisor(i, v->divisor);
+                DBG(SHUT_LOGD("glVertexAttribDivisor(%d, %d)\n", i, v->divisor);)
+            }
         } else {
             // single value case
             char* current = (char*)glstate->vavalue[i];
@@ -1572,7 +1684,8 @@ void realize_blitenv(int alpha) {
         glstate->gleshard->program = ((alpha)?glstate->blit->program_alpha:glstate->blit->program);
         gles_glUseProgram(glstate->gleshard->program);
     }
-    // set VertexAttrib if needed
+    // set VertexAttrib if needed, in the default vertex array
+    realize_hardvao(NULL, 0);
     unboundBuffers();
     for(int i=0; i<hardext.maxvattrib; i++) {
         vertexattrib_t *v = &glstate->gleshard->vertexattrib[i];
@@ -1645,6 +1758,9 @@ void builtin_Init(program_t *glprogram) {
     }
     glprogram->builtin_normalrescale = -1;
     glprogram->builtin_instanceID = -1;
+    glprogram->builtin_instanceBase = -1;
+    // nothing sent yet
+    memset(glprogram->builtin_gen, 0, sizeof(glprogram->builtin_gen));
     for (int i=0; i<MAX_CLIP_PLANES; i++)
         glprogram->builtin_clipplanes[i] = -1;
     glprogram->builtin_pointsprite.size = -1;
@@ -1705,6 +1821,7 @@ const char* frontlightprod_fpe_code = "_gl4es_FrontLightProduct_";
 const char* backlightprod_fpe_code = "_gl4es_BackLightProduct_";
 const char* normalrescale_code = "_gl4es_NormalScale";
 const char* instanceID_code = "_gl4es_InstanceID";
+const char* instanceBase_code = "_gl4es_InstanceBase";
 const char* clipplanes_code = "_gl4es_ClipPlane[";
 const char* clipplanes_fpe_code = "_gl4es_ClipPlane_";
 const char* point_code = "_gl4es_Point";
@@ -1832,6 +1949,11 @@ int builtin_CheckUniform(program_t *glprogram, char* name, GLint id, int size) {
         glprogram->builtin_instanceID = id;
         return 1;
     }
+    if(strncmp(name, instanceBase_code, strlen(instanceBase_code))==0)
+    {
+        glprogram->builtin_instanceBase = id;
+        return 1;
+    }
     if(strncmp(name, clipplanes_code, strlen(clipplanes_code))==0) {
         // it a clip plane! grab it's number
         int n = name[strlen(clipplanes_code)]-'0';   // only 6 clip planes, so this works
@@ -275,6 +275,12 @@ void APIENTRY_GLES fpe_glMaterialf(GLenum face, GLenum pname, const GLfloat para
 void APIENTRY_GLES fpe_glPointParameterfv(GLenum pname, const GLfloat * params);
 void APIENTRY_GLES fpe_glPointSize(GLfloat size);
 
+// Builtin uniforms are only sent for the groups whose state changed since the program last saw them.
+// Anything that changes the state behind a group must bump its generation with DIRTY_UNIFORMS
+// (generations are unique across all contexts, so a program shared by 2 contexts is still refreshed)
+extern unsigned int fpe_uniform_serial;
+#define DIRTY_UNIFORMS(group) glstate->uniform_gen[group] = ++fpe_uniform_serial
+
 void builtin_Init(program_t *glprogram);
 int builtin_CheckUniform(program_t *glprogram, char* name, GLint id, int size);
 int builtin_CheckVertexAttrib(program_t *glprogram, char* name, GLint id);
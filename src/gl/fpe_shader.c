@@ -3,6 +3,7 @@
 #include <stdio.h>
 
 #include "string_utils.h"
+#include "fpe_ubo.h"
 #include "init.h"
 #include "../glx/hardext.h"
 #include "logs.h"
@@ -164,6 +165,7 @@ const char* const* fpe_VertexShader(shaderconv_need_t* need, fpe_state_t *state)
     fpe_state_t default_state = {0};
     int is_default = !!need;
     if(!state) state = &default_state;
+    int ubo = !need && fpe_ubo_usable(state);
     int lighting = state->lighting;
     int twosided = state->twosided && lighting;
     if(need && ((need->need_color>1) || (need->need_secondary>1)))
@@ -214,6 +216,12 @@ const char* const* fpe_VertexShader(shaderconv_need_t* need, fpe_state_t *state)
             headers+=CountLine(buff);
         }
     }
+    if(ubo) {
+        // builtins are in the shared uniform block instead of loose uniforms
+        const char* decl = fpe_ubo_declaration();
+        ShadAppend(decl);
+        headers+=CountLine(decl);
+    }
     if(!is_default) {
         ShadAppend("varying vec4 Color;\n");  // might be unused...
         headers++;
@@ -230,7 +238,7 @@ const char* const* fpe_VertexShader(shaderconv_need_t* need, fpe_state_t *state)
             }
         }
     }
-    if(lighting) {
+    if(lighting && !ubo) {
         sprintf(buff, 
             "struct _gl4es_FPELightSourceParameters1\n"
             "{\n"
@@ -358,7 +366,7 @@ const char* const* fpe_VertexShader(shaderconv_need_t* need, fpe_state_t *state)
             sprintf(buff, "varying %s _gl4es_TexCoord_%d;\n", texvecsize[t-1], i);
             ShadAppend(buff);
             headers++;
-            if(state->texture[i].texmat) {
+            if(state->texture[i].texmat && !ubo) {
                 sprintf(buff, "uniform highp mat4 _gl4es_TextureMatrix_%d;\n", i);
                 ShadAppend(buff);
                 headers++;
@@ -831,6 +839,7 @@ const char* const* fpe_FragmentShader(shaderconv_need_t* need, fpe_state_t *stat
     int texturing = 0;
     char buff[1024];
     const char* fogp = hardext.highp?"highp":"mediump";
+    int ubo = !need && fpe_ubo_usable(state);
 
 
     strcpy(shad, fpeshader_signature);
@@ -854,6 +863,12 @@ const char* const* fpe_FragmentShader(shaderconv_need_t* need, fpe_state_t *stat
         ShadAppend(buff);
         headers+=CountLine(buff);
     }
+    if(ubo) {
+        // same block as the vertex shader, so both stages link
+        const char* decl = fpe_ubo_declaration();
+        ShadAppend(decl);
+        headers+=CountLine(decl);
+    }
     ShadAppend("varying vec4 Color;\n");
     headers++;
     if(twosided) {
@@ -0,0 +1,309 @@
+#include "fpe_ubo.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#include "../glx/hardext.h"
+#include "counters.h"
+#include "gl4es.h"
+#include "glstate.h"
+#include "init.h"
+#include "loader.h"
+#include "matrix.h"
+#include "matvec.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+// C side of the block, following std140 rules (vec3 + float share a vec4, mat3 is 3 vec4, structs are 16 bytes aligned)
+// It must stay in sync with the declaration built in fpe_ubo_declaration
+typedef struct {
+    GLfloat ambient[4];
+    GLfloat diffuse[4];
+    GLfloat specular[4];
+    GLfloat position[4];
+    GLfloat spotDirection[3];
+    GLfloat spotExponent;
+    GLfloat spotCosCutoff;
+    GLfloat constantAttenuation;
+    GLfloat linearAttenuation;
+    GLfloat quadraticAttenuation;
+} fpe_ubo_light_t;
+
+typedef struct {
+    GLfloat ambient[4];
+    GLfloat diffuse[4];
+    GLfloat specular[4];
+} fpe_ubo_lightprod_t;
+
+typedef struct {
+    GLfloat emission[4];
+    GLfloat ambient[4];
+    GLfloat diffuse[4];
+    GLfloat specular[4];
+    GLfloat shininess;
+    GLfloat pad[3];
+} fpe_ubo_material_t;
+
+typedef struct {
+    GLfloat color[4];
+    GLfloat density;
+    GLfloat start;
+    GLfloat end;
+    GLfloat scale;
+} fpe_ubo_fog_t;
+
+typedef struct {
+    GLfloat             mv[16];
+    GLfloat             mvp[16];
+    GLfloat             normal[12];
+    GLfloat             normalscale;
+    GLfloat             shininess[2];   // front / back
+    GLfloat             alpha[2];       // front / back
+    GLfloat             pad[3];
+    fpe_ubo_material_t  material[2];
+    GLfloat             lightmodel_ambient[4];
+    GLfloat             lightmodelprod[2][4];
+    fpe_ubo_fog_t       fog;
+    fpe_ubo_light_t     light[MAX_LIGHT];
+    fpe_ubo_lightprod_t lightprod[2][MAX_LIGHT];
+    GLfloat             texmat[MAX_TEX][16];
+} fpe_ubo_block_t;
+
+int fpe_ubo_usable(fpe_state_t *state) {
+    if(!globals4es.fpeubo || hardext.esversion<3 || !hardext.glsl300es)
+        return 0;
+    // texture streaming is an ES2 extension, not available in GLSL ES 3.00
+    for (int i=0; i<hardext.maxtex; i++)
+        if(state->texture[i].textype==FPE_TEX_STRM)
+            return 0;
+    return 1;
+}
+
+const char* fpe_ubo_declaration() {
+    static char *decl = NULL;
+    if(decl)
+        return decl;
+    static const char* structs =
+        "struct _gl4es_FPELightSourceParameters {\n"
+        " highp vec4 ambient;\n"
+        " highp vec4 diffuse;\n"
+        " highp vec4 specular;\n"
+        " highp vec4 position;\n"
+        " highp vec3 spotDirection;\n"
+        " highp float spotExponent;\n"
+        " highp float spotCosCutoff;\n"
+        " highp float constantAttenuation;\n"
+        " highp float linearAttenuation;\n"
+        " highp float quadraticAttenuation;\n"
+        "};\n"
+        "struct _gl4es_LightProducts {\n"
+        " highp vec4 ambient;\n"
+        " highp vec4 diffuse;\n"
+        " highp vec4 specular;\n"
+        "};\n"
+        "struct _gl4es_MaterialParameters {\n"
+        " highp vec4 emission;\n"
+        " highp vec4 ambient;\n"
+        " highp vec4 diffuse;\n"
+        " highp vec4 specular;\n"
+        " highp float shininess;\n"
+        "};\n"
+        "struct _gl4es_LightModelParameters {\n"
+        " highp vec4 ambient;\n"
+        "};\n"
+        "struct _gl4es_LightModelProducts {\n"
+        " highp vec4 sceneColor;\n"
+        "};\n"
+        "struct _gl4es_FogParameters {\n"
+        " highp vec4 color;\n"
+        " highp float density;\n"
+        " highp float start;\n"
+        " highp float end;\n"
+        " highp float scale;\n"
+        "};\n"
+        "layout(std140) uniform " FPE_UBO_NAME " {\n"
+        " highp mat4 _gl4es_ModelViewMatrix;\n"
+        " highp mat4 _gl4es_ModelViewProjectionMatrix;\n"
+        " highp mat3 _gl4es_NormalMatrix;\n"
+        " highp float _gl4es_NormalScale;\n"
+        " highp float _gl4es_FrontMaterial_shininess;\n"
+        " highp float _gl4es_BackMaterial_shininess;\n"
+        " highp float _gl4es_FrontMaterial_alpha;\n"
+        " highp float _gl4es_BackMaterial_alpha;\n"
+        " _gl4es_MaterialParameters _gl4es_FrontMaterial;\n"
+        " _gl4es_MaterialParameters _gl4es_BackMaterial;\n"
+        " _gl4es_LightModelParameters _gl4es_LightModel;\n"
+        " _gl4es_LightModelProducts _gl4es_FrontLightModelProduct;\n"
+        " _gl4es_LightModelProducts _gl4es_BackLightModelProduct;\n"
+        " _gl4es_FogParameters _gl4es_Fog;\n";
+    // the per light / per texture unit members are not arrays, to match the names used by the FPE shaders
+    int sz = strlen(structs) + MAX_LIGHT*200 + MAX_TEX*50 + 10;
+    decl = (char*)malloc(sz);
+    strcpy(decl, structs);
+    char buff[100];
+    for (int i=0; i<MAX_LIGHT; i++) {
+        sprintf(buff, " _gl4es_FPELightSourceParameters _gl4es_LightSource_%d;\n", i);
+        strcat(decl, buff);
+    }
+    for (int i=0; i<MAX_LIGHT; i++) {
+        sprintf(buff, " _gl4es_LightProducts _gl4es_FrontLightProduct_%d;\n", i);
+        strcat(decl, buff);
+    }
+    for (int i=0; i<MAX_LIGHT; i++) {
+        sprintf(buff, " _gl4es_LightProducts _gl4es_BackLightProduct_%d;\n", i);
+        strcat(decl, buff);
+    }
+    for (int i=0; i<MAX_TEX; i++) {
+        sprintf(buff, " highp mat4 _gl4es_TextureMatrix_%d;\n", i);
+        strcat(decl, buff);
+    }
+    strcat(decl, "};\n");
+    return decl;
+}
+
+void fpe_ubo_program(program_t *glprogram) {
+    glprogram->has_fpe_ubo = 0;
+    if(!globals4es.fpeubo || hardext.esversion<3)
+        return;
+    LOAD_GLES3(glGetUniformBlockIndex);
+    LOAD_GLES3(glUniformBlockBinding);
+    if(!gles_glGetUniformBlockIndex || !gles_glUniformBlockBinding)
+        return;
+    GLuint index = gles_glGetUniformBlockIndex(glprogram->id, FPE_UBO_NAME);
+    if(index==GL_INVALID_INDEX)
+        return;
+    gles_glUniformBlockBinding(glprogram->id, index, FPE_UBO_BINDING);
+    glprogram->has_fpe_ubo = 1;
+    DBG(SHUT_LOGD("Program %d uses the FPE uniform block (index %d)\n", glprogram->id, index);)
+}
+
+void fpe_ubo_update() {
+    LOAD_GLES(glBindBuffer);
+    LOAD_GLES(glBufferSubData);
+    fpe_ubo_block_t *b = (fpe_ubo_block_t*)glstate->fpe_ubo_data;
+    if(!glstate->fpe_ubo) {
+        LOAD_GLES(glGenBuffers);
+        LOAD_GLES(glBufferData);
+        LOAD_GLES3(glBindBufferBase);
+        gles_glGenBuffers(1, &glstate->fpe_ubo);
+        if(!glstate->fpe_ubo)
+            return;
+        if(!b)
+            b = glstate->fpe_ubo_data = calloc(1, sizeof(fpe_ubo_block_t));
+        // all the groups will be uploaded
+        memset(glstate->fpe_ubo_gen, 0, sizeof(glstate->fpe_ubo_gen));
+        gles_glBindBuffer(GL_UNIFORM_BUFFER, glstate->fpe_ubo);
+        gles_glBufferData(GL_UNIFORM_BUFFER, sizeof(fpe_ubo_block_t), NULL, GL_DYNAMIC_DRAW);
+        // nothing else binds this index in the driver (glBindBufferBase from the app is not forwarded)
+        gles_glBindBufferBase(GL_UNIFORM_BUFFER, FPE_UBO_BINDING, glstate->fpe_ubo);
+    }
+    unsigned int changed = 0;
+    for (int i=0; i<UG_MAX; i++)
+        if(glstate->fpe_ubo_gen[i]!=glstate->uniform_gen[i]) {
+            glstate->fpe_ubo_gen[i] = glstate->uniform_gen[i];
+            changed |= 1<<i;
+        }
+    #define CHANGED(A) (changed&(1<<UG_##A))
+    if(!(CHANGED(MODELVIEW) || CHANGED(PROJECTION) || CHANGED(TEXMATRIX) || CHANGED(LIGHT) || CHANGED(MATERIAL) || CHANGED(FOG)))
+        return;
+    // only the span of what changed is uploaded
+    size_t lo = sizeof(fpe_ubo_block_t), hi = 0;
+    #define DIRTY(A) do { \
+        size_t o = offsetof(fpe_ubo_block_t, A); \
+        if(o<lo) lo = o; \
+        if(o+sizeof(b->A)>hi) hi = o+sizeof(b->A); \
+    } while(0)
+
+    if(CHANGED(MODELVIEW) || CHANGED(PROJECTION)) {
+        memcpy(b->mvp, getMVPMat(), 16*sizeof(GLfloat));
+        DIRTY(mvp);
+    }
+    if(CHANGED(MODELVIEW)) {
+        memcpy(b->mv, getMVMat(), 16*sizeof(GLfloat));
+        const GLfloat *n = getNormalMat();
+        for (int i=0; i<3; i++)
+            memcpy(b->normal+i*4, n+i*3, 3*sizeof(GLfloat));
+        if(glstate->fpe_state && glstate->fpe_state->rescaling) {
+            const GLfloat *inv = getInvMVMat();
+            b->normalscale = 1.0f/sqrtf(inv[3*4+1]*inv[3*4+1]+inv[3*4+2]*inv[3*4+2]+inv[3*4+3]*inv[3*4+3]);
+        } else
+            b->normalscale = 1.0f;
+        DIRTY(mv);
+        DIRTY(normal);
+        DIRTY(normalscale);
+    }
+    if(CHANGED(TEXMATRIX)) {
+        for (int i=0; i<hardext.maxtex; i++)
+            memcpy(b->texmat[i], getTexMat(i), 16*sizeof(GLfloat));
+        DIRTY(texmat);
+    }
+    if(CHANGED(MATERIAL)) {
+        material_t *m[2] = {&glstate->material.front, &glstate->material.back};
+        for (int f=0; f<2; f++) {
+            memcpy(b->material[f].emission, m[f]->emission, 4*sizeof(GLfloat));
+            memcpy(b->material[f].ambient, m[f]->ambient, 4*sizeof(GLfloat));
+            memcpy(b->material[f].diffuse, m[f]->diffuse, 4*sizeof(GLfloat));
+            memcpy(b->material[f].specular, m[f]->specular, 4*sizeof(GLfloat));
+            b->material[f].shininess = b->shininess[f] = m[f]->shininess;
+            b->alpha[f] = m[f]->diffuse[3];
+        }
+        DIRTY(shininess);
+        DIRTY(alpha);
+        DIRTY(material);
+    }
+    if(CHANGED(LIGHT)) {
+        memcpy(b->lightmodel_ambient, glstate->light.ambient, 4*sizeof(GLfloat));
+        for (int i=0; i<hardext.maxlights; i++) {
+            light_t *l = &glstate->light.lights[i];
+            fpe_ubo_light_t *u = &b->light[i];
+            memcpy(u->ambient, l->ambient, 4*sizeof(GLfloat));
+            memcpy(u->diffuse, l->diffuse, 4*sizeof(GLfloat));
+            memcpy(u->specular, l->specular, 4*sizeof(GLfloat));
+            memcpy(u->position, l->position, 4*sizeof(GLfloat));
+            memcpy(u->spotDirection, l->spotDirection, 3*sizeof(GLfloat));
+            u->spotExponent = l->spotExponent;
+            u->spotCosCutoff = cosf(l->spotCutoff*3.1415926535f/180.0f);
+            u->constantAttenuation = l->constantAttenuation;
+            u->linearAttenuation = l->linearAttenuation;
+            u->quadraticAttenuation = l->quadraticAttenuation;
+        }
+        DIRTY(lightmodel_ambient);
+        DIRTY(light);
+    }
+    if(CHANGED(LIGHT) || CHANGED(MATERIAL)) {
+        material_t *m[2] = {&glstate->material.front, &glstate->material.back};
+        for (int f=0; f<2; f++) {
+            vector4_mult(m[f]->ambient, glstate->light.ambient, b->lightmodelprod[f]);
+            vector4_add(b->lightmodelprod[f], m[f]->emission, b->lightmodelprod[f]);
+            for (int i=0; i<hardext.maxlights; i++) {
+                light_t *l = &glstate->light.lights[i];
+                vector4_mult(m[f]->ambient, l->ambient, b->lightprod[f][i].ambient);
+                vector4_mult(m[f]->diffuse, l->diffuse, b->lightprod[f][i].diffuse);
+                vector4_mult(m[f]->specular, l->specular, b->lightprod[f][i].specular);
+            }
+        }
+        DIRTY(lightmodelprod);
+        DIRTY(lightprod);
+    }
+    if(CHANGED(FOG)) {
+        memcpy(b->fog.color, glstate->fog.color, 4*sizeof(GLfloat));
+        b->fog.density = glstate->fog.density;
+        b->fog.start = glstate->fog.start;
+        b->fog.end = glstate->fog.end;
+        b->fog.scale = 1.f/(glstate->fog.end - glstate->fog.start);
+        DIRTY(fog);
+    }
+    #undef DIRTY
+    #undef CHANGED
+
+    gles_glBindBuffer(GL_UNIFORM_BUFFER, glstate->fpe_ubo);
+    gles_glBufferSubData(GL_UNIFORM_BUFFER, lo, hi-lo, (char*)b+lo);
+    COUNTER_INC(fpe_ubo_uploads);
+    COUNTER_ADD(fpe_ubo_bytes, hi-lo);
+}
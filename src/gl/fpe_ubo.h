@@ -0,0 +1,24 @@
+#ifndef _GL4ES_FPE_UBO_H_
+#define _GL4ES_FPE_UBO_H_
+
+#include "fpe.h"
+#include "program.h"
+
+// Fixed pipeline builtins in a std140 uniform block (see LIBGL_FPE_UBO, GLES3 only)
+// The matrices, lights, materials and fog used by the FPE shaders are declared in the same block
+// by every FPE program. The block lives in one buffer per context, bound once to FPE_UBO_BINDING,
+// and each state change is uploaded once instead of being sent again to every FPE program using it.
+
+#define FPE_UBO_NAME    "_gl4es_FPEBlock"
+#define FPE_UBO_BINDING 23  // last binding point guaranteed by GLES 3.0
+
+// 1 if the FPE shaders for that state can use the block
+int fpe_ubo_usable(fpe_state_t *state);
+// GLSL declaration of the block (and of the struct types it uses), identical for every stage
+const char* fpe_ubo_declaration();
+// after link: bind the block of the program (if any) to FPE_UBO_BINDING, and set has_fpe_ubo
+void fpe_ubo_program(program_t *glprogram);
+// upload the builtin groups that changed since last upload (and create the buffer if needed)
+void fpe_ubo_update();
+
+#endif // _GL4ES_FPE_UBO_H_
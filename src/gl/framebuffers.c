@@ -490,13 +490,13 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                 tex->adjust=(tex->width!=tex->nwidth || tex->height!=tex->nheight);
                 tex->shrink = 0; tex->useratio = 0;
                 int oldactive = glstate->texture.active;
-                if(oldactive) gles_glActiveTexture(GL_TEXTURE0);
+                gles_glActiveTexture(GL_TEXTURE0);
                 gltexture_t *bound = glstate->texture.bound[0/*glstate->texture.active*/][ENABLED_TEX2D];
                 GLuint oldtex = bound->glname;
                 if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, tex->glname);
                 gles_glTexImage2D(GL_TEXTURE_2D, 0, tex->format, tex->nwidth, tex->nheight, 0, tex->format, tex->type, NULL);
                 if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, oldtex);
-                if(oldactive) gles_glActiveTexture(GL_TEXTURE0+oldactive);
+                gles_glActiveTexture(GL_TEXTURE0+oldactive);
             }
             int need_change = (globals4es.potframebuffer && (npot(twidth)!=twidth || npot(theight)!=theight))?1:0;
             if((tex->type==GL_FLOAT && !hardext.floatfbo) || (tex->type==GL_HALF_FLOAT_OES && !hardext.halffloatfbo)) {
@@ -518,13 +518,13 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                     tex->adjust=(tex->width!=tex->nwidth || tex->height!=tex->nheight);
                 }
                 int oldactive = glstate->texture.active;
-                if(oldactive) gles_glActiveTexture(GL_TEXTURE0);
+                gles_glActiveTexture(GL_TEXTURE0);
                 gltexture_t *bound = glstate->texture.bound[0/*glstate->texture.active*/][ENABLED_TEX2D];
                 GLuint oldtex = bound->glname;
                 if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, tex->glname);
                 gles_glTexImage2D(GL_TEXTURE_2D, 0, tex->format, tex->nwidth, tex->nheight, 0, tex->format, tex->type, NULL);
                 if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, oldtex);
-                if(oldactive) gles_glActiveTexture(GL_TEXTURE0+oldactive);
+                gles_glActiveTexture(GL_TEXTURE0+oldactive);
             }
             twidth = tex->nwidth;
             theight = tex->nheight;
@@ -607,7 +607,7 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                 tex->fpe_format = FPE_TEX_DEPTH;
                 realize_textures(0);
                 int oldactive = glstate->texture.active;
-                if(oldactive) gles_glActiveTexture(GL_TEXTURE0);
+                gles_glActiveTexture(GL_TEXTURE0);
                 gltexture_t *bound = glstate->texture.bound[0/*glstate->texture.active*/][ENABLED_TEX2D];
                 GLuint oldtex = bound->glname;
                 if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, tex->glname);
@@ -617,7 +617,7 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                 gles_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
                 gles_glTexImage2D(GL_TEXTURE_2D, 0, tex->format, tex->nwidth, tex->nheight, 0, tex->format, tex->type, NULL);
                 if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, oldtex);
-                if(oldactive) gles_glActiveTexture(GL_TEXTURE0+oldactive);
+                gles_glActiveTexture(GL_TEXTURE0+oldactive);
             }
             // bind the depth texture...
             gles_glFramebufferTexture2D(ntarget, attachment, GL_TEXTURE_2D, texture, 0);
@@ -649,7 +649,7 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                     gl4es_glGenTextures(1, &texture);
                     realize_textures(0);
                     int oldactive = glstate->texture.active;
-                    if(oldactive) gles_glActiveTexture(GL_TEXTURE0);
+                    gles_glActiveTexture(GL_TEXTURE0);
                     gltexture_t *bound = glstate->texture.bound[0/*glstate->texture.active*/][ENABLED_TEX2D];
                     GLuint oldtex = bound->glname;
                     int nwidth = tex->nwidth;
@@ -665,14 +665,14 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                     tex->type = (hardext.stenciltex)?GL_UNSIGNED_BYTE:GL_UNSIGNED_INT_24_8;
                     gl4es_glTexImage2D(GL_TEXTURE_2D, 0, tex->format, nwidth, nheight, 0, tex->format, tex->type, NULL);
                     if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, oldtex);
-                    if(oldactive) gles_glActiveTexture(GL_TEXTURE0+oldactive);
+                    gles_glActiveTexture(GL_TEXTURE0+oldactive);
                 } else {
                     tex->format = GL_STENCIL_INDEX8;
                     if(tex->type!=GL_UNSIGNED_BYTE && tex->type!=GL_UNSIGNED_SHORT && tex->type!=GL_FLOAT) tex->type = GL_UNSIGNED_BYTE;
                     tex->fpe_format = FPE_TEX_DEPTH;
                     realize_textures(0);
                     int oldactive = glstate->texture.active;
-                    if(oldactive) gles_glActiveTexture(GL_TEXTURE0);
+                    gles_glActiveTexture(GL_TEXTURE0);
                     gltexture_t *bound = glstate->texture.bound[0/*glstate->texture.active*/][ENABLED_TEX2D];
                     GLuint oldtex = bound->glname;
                     if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, tex->glname);
@@ -682,7 +682,7 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                     gles_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
                     gles_glTexImage2D(GL_TEXTURE_2D, 0, tex->format, tex->nwidth, tex->nheight, 0, tex->format, tex->type, NULL);
                     if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, oldtex);
-                    if(oldactive) gles_glActiveTexture(GL_TEXTURE0+oldactive);
+                    gles_glActiveTexture(GL_TEXTURE0+oldactive);
                 }
             }
             // bind the stencil texture...
@@ -712,7 +712,7 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                     tex->type = GL_UNSIGNED_INT_24_8;
                     tex->fpe_format = FPE_TEX_DEPTH; // add depth_stencil?
                     int oldactive = glstate->texture.active;
-                    if(oldactive) gles_glActiveTexture(GL_TEXTURE0);
+                    gles_glActiveTexture(GL_TEXTURE0);
                     gltexture_t *bound = glstate->texture.bound[0/*glstate->texture.active*/][ENABLED_TEX2D];
                     GLuint oldtex = bound->glname;
                     if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, tex->glname);
@@ -722,7 +722,7 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                     gles_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
                     gles_glTexImage2D(GL_TEXTURE_2D, 0, tex->format, tex->nwidth, tex->nheight, 0, tex->format, tex->type, NULL);
                     if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, oldtex);
-                    if(oldactive) gles_glActiveTexture(GL_TEXTURE0+oldactive);
+                    gles_glActiveTexture(GL_TEXTURE0+oldactive);
                 }
                 gles_glFramebufferTexture2D(ntarget, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, texture, 0);
                 gles_glFramebufferTexture2D(ntarget, GL_STENCIL_ATTACHMENT, GL_TEXTURE_2D, texture, 0);
@@ -746,7 +746,7 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                     if(tex->type!=GL_UNSIGNED_INT && tex->type!=GL_UNSIGNED_SHORT && tex->type!=GL_FLOAT) tex->type = (hardext.depth24)?GL_UNSIGNED_INT:GL_UNSIGNED_SHORT;
                     tex->fpe_format = FPE_TEX_DEPTH;
                     int oldactive = glstate->texture.active;
-                    if(oldactive) gles_glActiveTexture(GL_TEXTURE0);
+                    gles_glActiveTexture(GL_TEXTURE0);
                     gltexture_t *bound = glstate->texture.bound[0/*glstate->texture.active*/][ENABLED_TEX2D];
                     GLuint oldtex = bound->glname;
                     if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, tex->glname);
@@ -756,7 +756,7 @@ void APIENTRY_GL4ES gl4es_glFramebufferTexture2D(GLenum target, GLenum attachmen
                     gles_glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
                     gles_glTexImage2D(GL_TEXTURE_2D, 0, tex->format, tex->nwidth, tex->nheight, 0, tex->format, tex->type, NULL);
                     if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, oldtex);
-                    if(oldactive) gles_glActiveTexture(GL_TEXTURE0+oldactive);
+                    gles_glActiveTexture(GL_TEXTURE0+oldactive);
                 }
                 // bind the depth texture...
                 gles_glFramebufferTexture2D(ntarget, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, texture, 0);
@@ -1040,7 +1040,7 @@ void APIENTRY_GL4ES gl4es_glRenderbufferStorage(GLenum target, GLenum internalfo
         LOAD_GLES(glBindTexture);
         LOAD_GLES(glTexImage2D);
         int oldactive = glstate->texture.active;
-        if(oldactive) gles_glActiveTexture(GL_TEXTURE0);
+        gles_glActiveTexture(GL_TEXTURE0);
         gltexture_t *bound = glstate->texture.bound[0/*glstate->texture.active*/][ENABLED_TEX2D];
         GLuint oldtex = bound->glname;
         if (oldtex!=rend->secondarytexture) gles_glBindTexture(GL_TEXTURE_2D, rend->secondarytexture);
@@ -1048,7 +1048,7 @@ void APIENTRY_GL4ES gl4es_glRenderbufferStorage(GLenum target, GLenum internalfo
         tex->nheight = tex->height = height;
         gles_glTexImage2D(GL_TEXTURE_2D, 0, tex->format, tex->nwidth, tex->nheight, 0, tex->format, tex->type, NULL);
         if (oldtex!=tex->glname) gles_glBindTexture(GL_TEXTURE_2D, oldtex);
-        if(oldactive) gles_glActiveTexture(GL_TEXTURE0+oldactive);
+        gles_glActiveTexture(GL_TEXTURE0+oldactive);
     }
 
     rend->width  = width;
@@ -1239,8 +1239,7 @@ void createMainFBO(int width, int height) {
     }
     DBG(SHUT_LOGD("LIBGL: Create FBO of %ix%i 32bits\n", width, height);)
     // switch to texture unit 0 if needed
-    if (glstate->texture.active != 0)
-        gles_glActiveTexture(GL_TEXTURE0);
+    gles_glActiveTexture(GL_TEXTURE0);
     if (glstate->texture.client != 0 && gles_glClientActiveTexture)
         gles_glClientActiveTexture(GL_TEXTURE0);
         
@@ -1289,8 +1288,7 @@ void createMainFBO(int width, int height) {
 
     // Put everything back
     gles_glBindTexture(GL_TEXTURE_2D, glstate->texture.bound[0][ENABLED_TEX2D]->glname);
-    if (glstate->texture.active != 0)
-        gles_glActiveTexture(GL_TEXTURE0 + glstate->texture.active);
+    gles_glActiveTexture(GL_TEXTURE0 + glstate->texture.active);
     if (glstate->texture.client != 0 && gles_glClientActiveTexture)
         gles_glClientActiveTexture(GL_TEXTURE0 + glstate->texture.client);
     GLuint current_rb = glstate->fbo.current_rb->renderbuffer;
@@ -15,14 +15,19 @@
 #include "../glx/hardext.h"
 #include "wrap/gl4es.h"
 #include "array.h"
+#include "counters.h"
 #include "debug.h"
+#include "drawmerge.h"
 #include "enum_info.h"
 #include "fpe.h"
 #include "framebuffers.h"
 #include "glstate.h"
 #include "init.h"
+#include "listopt.h"
 #include "loader.h"
 #include "matrix.h"
+#include "perflog.h"
+#include "tracer.h"
 #include "buffers.h"
 #include "logs.h"
 #include "config.h"
@@ -285,6 +290,7 @@ AliasExport(void,glInterleavedArrays,,(GLenum format, GLsizei stride, const GLvo
 
 // immediate mode functions
 void APIENTRY_GL4ES gl4es_glBegin(GLenum mode) {
+    drawmerge_flush();
     glstate->list.begin = 1;
     if (!glstate->list.active)
         glstate->list.active = alloc_renderlist();
@@ -888,14 +894,20 @@ void APIENTRY_GL4ES gl4es_glEndList(void) {
     if (glstate->list.compiling) {
 	// Free the previous list if it exist...
         free_renderlist(kh_value(lists, k));
-        renderlist_t* l = kh_value(lists, k) = GetFirst(glstate->list.active);
+        renderlist_t* l = GetFirst(glstate->list.active);
         // set name
         while(l) {
             l->name = list;
             l = l->next;
         }
         glstate->list.compiling = false;
-        end_renderlist(glstate->list.active);
+        l = GetFirst(glstate->list.active);
+        if(globals4es.listopt)
+            l = listopt_optimize(l);
+        kh_value(lists, k) = l;
+        while(l->next)
+            l = l->next;
+        end_renderlist(l);
         glstate->list.active = NULL;
 
         if (glstate->list.mode == GL_COMPILE_AND_EXECUTE) {
@@ -922,11 +934,10 @@ void APIENTRY_GL4ES gl4es_glCallList(GLuint list) {
 }
 AliasExport(void,glCallList,,(GLuint list));
 
-void APIENTRY_GL4ES glPushCall(void *call) {
-    if (glstate->list.active) {
-		NewStage(glstate->list.active, STAGE_GLCALL);
-        rlPushCall(glstate->list.active, call);
-    }
+// room for a packed call of "size" bytes at the end of the active list (there must be one)
+void* APIENTRY_GL4ES glPushCallAlloc(int size) {
+    NewStage(glstate->list.active, STAGE_GLCALL);
+    return rlPushCall(glstate->list.active, size);
 }
 
 void APIENTRY_GL4ES gl4es_glCallLists(GLsizei n, GLenum type, const GLvoid *lists) {
@@ -1026,6 +1037,7 @@ void APIENTRY_GL4ES gl4es_glPolygonMode(GLenum face, GLenum mode) {
             return;
         }
         else gl4es_flush();
+    FLUSH_BEGINEND;
     switch(mode) {
 	case GL_LINE:
 	case GL_POINT:
@@ -1044,6 +1056,8 @@ AliasExport(void,glPolygonMode,,(GLenum face, GLenum mode));
 void gl4es_flush() {
     if(glstate->list.compiling)
         return;
+    // flush the merged draws
+    drawmerge_flush();
     // flush internal list
     renderlist_t *mylist = glstate->list.active?extend_renderlist(glstate->list.active):NULL;
     if (mylist) {
@@ -1052,6 +1066,7 @@ void gl4es_flush() {
         mylist = end_renderlist(mylist);
         draw_renderlist(mylist);
         free_renderlist(mylist);
+        COUNTER_INC(renderlist_flushes);
     }
     glstate->list.active = NULL;
 }
@@ -1324,7 +1339,7 @@ void amiga_pre_swap()
 NonAliasExportDecl(void,gl4es_pre_swap,())
 #endif
 {
-    if (glstate->list.active) gl4es_flush();
+    if (glstate->list.active || glstate->list.pending) gl4es_flush();
     if (glstate->raster.bm_drawing) bitmap_flush();
 
     if (globals4es.usefbo) {
@@ -1334,6 +1349,19 @@ NonAliasExportDecl(void,gl4es_pre_swap,())
     }
 }
 
+static int glx_frame_ended = 0;
+void end_frame(int glx) {
+    // glXSwapBuffers ends its frames, gl4es_post_swap only ends the ones of the platforms swapping by themselves
+    if(!glx && glx_frame_ended) {
+        glx_frame_ended = 0;
+        return;
+    }
+    glx_frame_ended = glx;
+    counters_frame();
+    perflog_frame();
+    tracer_frame();
+}
+
 void show_fps() {
     if (globals4es.showfps) 
     {
@@ -1381,6 +1409,7 @@ NonAliasExportDecl(void,gl4es_post_swap,())
 #endif
 {
 		show_fps();
+		end_frame(0);
 
     // If drawing in fbo, rebind it...
     if (globals4es.usefbo) {
@@ -187,7 +187,10 @@ void rlVertexP3ui(renderlist_t* list, GLuint p1, GLuint p2, GLuint p3);
 void rlVertexP2ui(renderlist_t* list, GLuint p1, GLuint p2);
 
 // custom functions
-void APIENTRY_GL4ES glPushCall(void *call);
+void* APIENTRY_GL4ES glPushCallAlloc(int size);
+
+// per frame counters, log and trace, called once per swap (glx is 1 from glXSwapBuffers)
+void end_frame(int glx);
 
 #endif // _GL4ES_GL4ES_H_
 #ifdef __cplusplus
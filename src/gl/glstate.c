@@ -1,10 +1,14 @@
 #include "glstate.h"
 
 #include "../glx/hardext.h"
+#include "drawmerge.h"
+#include "listpool.h"
+#include "listvbo.h"
 #include "fpe.h"
 #include "framebuffers.h"
 #include "gl4es.h"
 #include "glstate.h"
+#include "hardstate.h"
 #include "init.h"
 #include "loader.h"
 #include "oldprogram.h"
@@ -41,6 +45,12 @@ static void free_framebuffer(glframebuffer_t *fb)
     free(fb);
 }
 
+static void free_vao(glvao_t *vao)
+{
+    VaoHardClear(vao);
+    free(vao);
+}
+
 static void free_texture(gltexture_t *tex)
 {
     LOAD_GLES(glDeleteTextures);
@@ -58,7 +68,13 @@ void CopyGLEShard(void* dst, const void* src)
 {
     if(!dst || !src)
         return;
-    memcpy(((glstate_t*)dst)->gleshard, ((const glstate_t*)src)->gleshard, sizeof(gleshard_t));
+    // the driver goes on with the default vertex array, the native ones of src are not in dst
+    if(src==glstate)
+        realize_hardvao(NULL, 0);
+    gleshard_t *hard = ((glstate_t*)dst)->gleshard;
+    memcpy(hard, ((const glstate_t*)src)->gleshard, sizeof(gleshard_t));
+    hard->hardvao = &hard->defaultvao;
+    hard->vertexattrib = hard->defaultvao.vertexattrib;
 }
 
 void* NewGLState(void* shared_glstate, int es2only) {
@@ -79,6 +95,7 @@ void* NewGLState(void* shared_glstate, int es2only) {
             (*copy_state->shared_cnt)++;
         glstate->shared_cnt = copy_state->shared_cnt;
         glstate->headlists = copy_state->headlists;
+        glstate->listvbo = copy_state->listvbo;
         glstate->actual_tex2d = copy_state->actual_tex2d;
         glstate->texture.list = copy_state->texture.list;
         glstate->glsl = copy_state->glsl;
@@ -152,6 +169,7 @@ void* NewGLState(void* shared_glstate, int es2only) {
         khash_t(gllisthead) *list = glstate->headlists = kh_init(gllisthead);
 		k = kh_put(gllisthead, list, 1, &ret);
 		kh_del(gllisthead, list, k);
+        glstate->listvbo = (listvbo_t*)calloc(1, sizeof(listvbo_t));
     }
     // actual_tex2d
     if(!shared_glstate)
@@ -160,6 +178,9 @@ void* NewGLState(void* shared_glstate, int es2only) {
     }
     // glsl
     glstate->gleshard = (gleshard_t*)calloc(1, sizeof(gleshard_t)); // Not shared!
+    glstate->gleshard->hardvao = &glstate->gleshard->defaultvao;
+    glstate->gleshard->vertexattrib = glstate->gleshard->defaultvao.vertexattrib;
+    hardstate_reset(glstate->gleshard);
     if(!shared_glstate)
     {
         glstate->glsl = (glsl_t*)malloc(sizeof(glsl_t));
@@ -213,6 +234,9 @@ void* NewGLState(void* shared_glstate, int es2only) {
 
     // init the matrix tracking
     init_matrix(glstate);
+    // fresh generations, so every program sends its builtin uniforms on first use with this context
+    for (int i=0; i<UG_MAX; i++)
+        DIRTY_UNIFORMS(i);
 
     // init the textures
     {
@@ -485,8 +509,11 @@ void DeleteGLState(void* oldstate) {
         )                                   \
         kh_destroy(K, state->N);            \
     }
-    free_hashmap(glvao_t, vaos, glvao, free);
+    free_hashmap(glvao_t, vaos, glvao, free_vao);
     if(!state->shared_cnt) {
+        // the whole pool goes away after the lists
+        if(state->listvbo)
+            state->listvbo->closing = 1;
         free_hashmap(glbuffer_t, buffers, buff, free);
         free_hashmap(gltexture_t, texture.list, tex, free_texture);
         free_hashmap(renderlist_t, headlists, gllisthead, free_renderlist);
@@ -512,6 +539,7 @@ void DeleteGLState(void* oldstate) {
     #undef freemap
     // free active list
     if(!state->shared_cnt && state->list.active) free_renderlist(state->list.active);
+    if(!state->shared_cnt) listvbo_destroy(state->listvbo);
 
     // free matrix stack
     #define free_matrix(A)                  \
@@ -544,6 +572,12 @@ void DeleteGLState(void* oldstate) {
     // scratch buffer
     if(state->scratch)
         free(state->scratch);
+    if(state->stream_staging)
+        free(state->stream_staging);
+    if(state->fpe_ubo_data)
+        free(state->fpe_ubo_data);
+    drawmerge_free(state->drawmerge);
+    listpool_destroy(state->listpool);
     // merger buffers
     if(state->merger_master)
         free(state->merger_master);
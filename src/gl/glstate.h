@@ -30,12 +30,19 @@ struct glstate_s {
     int                 polygon_mode;
     int                 clamp_read_color;
     namestack_t         namestack;
+    // derived matrices, computed on demand (see matrix.h) and stamped with the gen of the stacks they come from
     GLfloat             mvp_matrix[16];
-    int                 mvp_matrix_dirty;
+    unsigned int        mvp_matrix_gen[2];
+    GLfloat             inv_mvp_matrix[16];
+    unsigned int        inv_mvp_matrix_gen[2];
     GLfloat             inv_mv_matrix[16];
-    int                 inv_mv_matrix_dirty;
+    unsigned int        inv_mv_matrix_gen;
     GLfloat             normal_matrix[9];
-    int                 normal_matrix_dirty;
+    unsigned int        normal_matrix_gen;
+    GLfloat             inv_p_matrix[16];
+    unsigned int        inv_p_matrix_gen;
+    GLfloat             inv_tex_matrix[MAX_TEX][16];
+    unsigned int        inv_tex_matrix_gen[MAX_TEX];
     matrixstack_t       *modelview_matrix;
     matrixstack_t       *projection_matrix;
     matrixstack_t       **texture_matrix;
@@ -85,6 +92,7 @@ struct glstate_s {
     fpe_fpe_t           *fpe;
     fpestatus_t         fpe_client;
     fpe_cache_t         *fpe_cache;
+    unsigned int        uniform_gen[UG_MAX];    // generation of each builtin uniform group (see DIRTY_UNIFORMS)
     gleshard_t          *gleshard;          //shared
     glesblit_t          *blit;
     fbo_t               fbo;
@@ -111,6 +119,25 @@ struct glstate_s {
     GLsizei             scratch_vertex_size;
     GLuint              scratch_indices;
     GLsizei             scratch_indices_size;
+    // shared GL_QUADS to GL_TRIANGLES indices VBO (grow only)
+    GLuint              quad_indices;
+    GLsizei             quad_indices_cap;   // in vertices
+    // client arrays streaming ring VBO
+    GLuint              stream_vbo;
+    int                 stream_pos;
+    void*               stream_staging;
+    int                 stream_staging_size;
+    int                 stream_mapped[MAX_VATTRIB];
+    // consecutive small draws merger (see drawmerge.h)
+    struct drawmerge_s* drawmerge;
+    // recycled renderlists and arrays blocks (see listpool.h)
+    struct listpool_s*  listpool;
+    // pooled VBO of the display lists (see listvbo.h), shared with the shared contexts like the lists
+    struct listvbo_s*   listvbo;
+    // FPE builtins uniform block (see fpe_ubo.h)
+    GLuint              fpe_ubo;
+    void*               fpe_ubo_data;
+    unsigned int        fpe_ubo_gen[UG_MAX];    // generation of each builtin group in the block
     // Implementation read
     GLenum              readf; // implementation Read Format
     GLenum              readt; // implementation Read Type
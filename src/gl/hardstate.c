@@ -0,0 +1,379 @@
+#include "hardstate.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "counters.h"
+#include "debug.h"
+#include "gl4es.h"
+#include "glstate.h"
+#include "init.h"
+#include "logs.h"
+#include "wrap/gles.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+// the real driver functions
+#define HARD_PROC(name) static name##_PTR real_##name = NULL
+HARD_PROC(glEnable);
+HARD_PROC(glDisable);
+HARD_PROC(glBlendFunc);
+HARD_PROC(glBlendFuncSeparate);
+HARD_PROC(glBlendEquation);
+HARD_PROC(glBlendEquationSeparate);
+HARD_PROC(glBlendColor);
+HARD_PROC(glDepthFunc);
+HARD_PROC(glDepthMask);
+HARD_PROC(glDepthRangef);
+HARD_PROC(glCullFace);
+HARD_PROC(glFrontFace);
+HARD_PROC(glViewport);
+HARD_PROC(glScissor);
+HARD_PROC(glColorMask);
+HARD_PROC(glActiveTexture);
+HARD_PROC(glBindTexture);
+HARD_PROC(glDeleteTextures);
+HARD_PROC(glBindBuffer);
+HARD_PROC(glDeleteBuffers);
+#undef HARD_PROC
+
+// capabilities that are a single global bit on the driver (texture enables are per unit, so not here)
+static const GLenum hard_caps[] = {
+    GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST, GL_STENCIL_TEST,
+    GL_POLYGON_OFFSET_FILL, GL_DITHER, GL_SAMPLE_ALPHA_TO_COVERAGE, GL_SAMPLE_COVERAGE,
+    GL_PRIMITIVE_RESTART_FIXED_INDEX, GL_RASTERIZER_DISCARD,
+    // GLES 1.1 only
+    GL_LIGHTING, GL_FOG, GL_ALPHA_TEST, GL_NORMALIZE, GL_RESCALE_NORMAL, GL_COLOR_MATERIAL,
+    GL_LIGHT0, GL_LIGHT1, GL_LIGHT2, GL_LIGHT3, GL_LIGHT4, GL_LIGHT5, GL_LIGHT6, GL_LIGHT7,
+    GL_CLIP_PLANE0, GL_CLIP_PLANE1, GL_CLIP_PLANE2, GL_CLIP_PLANE3, GL_CLIP_PLANE4, GL_CLIP_PLANE5
+};
+#define HARD_NCAPS  (sizeof(hard_caps)/sizeof(hard_caps[0]))
+
+static GLuint cap_bit(GLenum cap) {
+    for (int i=0; i<HARD_NCAPS; ++i)
+        if(hard_caps[i]==cap)
+            return 1u<<i;
+    return 0;
+}
+
+static int tex_target(GLenum target) {
+    switch(target) {
+        case GL_TEXTURE_2D: return HARD_TEX_2D;
+        case GL_TEXTURE_CUBE_MAP: return HARD_TEX_CUBE_MAP;
+        case GL_TEXTURE_3D: return HARD_TEX_3D;
+        case GL_TEXTURE_2D_ARRAY: return HARD_TEX_2D_ARRAY;
+    }
+    return -1;
+}
+
+static int buf_target(GLenum target) {
+    switch(target) {
+        case GL_ARRAY_BUFFER: return HARD_BUF_ARRAY;
+        case GL_ELEMENT_ARRAY_BUFFER: return HARD_BUF_ELEMENT_ARRAY;
+        case GL_COPY_READ_BUFFER: return HARD_BUF_COPY_READ;
+        case GL_COPY_WRITE_BUFFER: return HARD_BUF_COPY_WRITE;
+        case GL_PIXEL_PACK_BUFFER: return HARD_BUF_PIXEL_PACK;
+        case GL_PIXEL_UNPACK_BUFFER: return HARD_BUF_PIXEL_UNPACK;
+        case GL_UNIFORM_BUFFER: return HARD_BUF_UNIFORM;
+    }
+    return -1;
+}
+
+void hardstate_reset(gleshard_t *hard) {
+    // the driver state is not known, except for the active texture that was always supposed to start at 0
+    hard->enabled = 0;
+    hard->enabled_known = 0;
+    for (int i=0; i<4; ++i) {
+        hard->blend_func[i] = HARD_UNKNOWN;
+        hard->blend_color[i] = NAN;
+        hard->viewport[i] = hard->scissor[i] = -1;
+    }
+    hard->blend_eq[0] = hard->blend_eq[1] = HARD_UNKNOWN;
+    hard->depth_func = HARD_UNKNOWN;
+    hard->depth_mask = HARD_UNKNOWN;
+    hard->depth_range[0] = hard->depth_range[1] = NAN;
+    hard->cull_face = HARD_UNKNOWN;
+    hard->front_face = HARD_UNKNOWN;
+    hard->color_mask = HARD_UNKNOWN;
+    memset(hard->texture, 0xff, sizeof(hard->texture));
+    memset(hard->buffer, 0xff, sizeof(hard->buffer));
+}
+
+// a state change that was already on the driver (with LIBGL_NOSHADOW, the state is still tracked but everything is sent)
+#define ELIDE(...)  if(!globals4es.noshadow) {COUNTER_INC(state_elided); DBG(SHUT_LOGD(__VA_ARGS__);) return;}
+#define SENT()      COUNTER_INC(state_sent)
+// no context yet: just forward the call
+#define HARD(name, ...) \
+    if(!glstate) { real_##name(__VA_ARGS__); return; } \
+    gleshard_t *hard = glstate->gleshard
+
+static void APIENTRY_GLES hard_glEnable(GLenum cap) {
+    HARD(glEnable, cap);
+    GLuint bit = cap_bit(cap);
+    if(bit) {
+        if((hard->enabled_known&bit) && (hard->enabled&bit))
+            ELIDE("elided glEnable(%s)\n", PrintEnum(cap));
+        hard->enabled_known |= bit;
+        hard->enabled |= bit;
+    }
+    SENT();
+    real_glEnable(cap);
+}
+
+static void APIENTRY_GLES hard_glDisable(GLenum cap) {
+    HARD(glDisable, cap);
+    GLuint bit = cap_bit(cap);
+    if(bit) {
+        if((hard->enabled_known&bit) && !(hard->enabled&bit))
+            ELIDE("elided glDisable(%s)\n", PrintEnum(cap));
+        hard->enabled_known |= bit;
+        hard->enabled &= ~bit;
+    }
+    SENT();
+    real_glDisable(cap);
+}
+
+static void APIENTRY_GLES hard_glBlendFunc(GLenum sfactor, GLenum dfactor) {
+    HARD(glBlendFunc, sfactor, dfactor);
+    if(hard->blend_func[0]==sfactor && hard->blend_func[1]==dfactor
+     && hard->blend_func[2]==sfactor && hard->blend_func[3]==dfactor)
+        ELIDE("elided glBlendFunc(%s, %s)\n", PrintEnum(sfactor), PrintEnum(dfactor));
+    hard->blend_func[0] = hard->blend_func[2] = sfactor;
+    hard->blend_func[1] = hard->blend_func[3] = dfactor;
+    SENT();
+    real_glBlendFunc(sfactor, dfactor);
+}
+
+static void APIENTRY_GLES hard_glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) {
+    HARD(glBlendFuncSeparate, sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+    if(hard->blend_func[0]==sfactorRGB && hard->blend_func[1]==dfactorRGB
+     && hard->blend_func[2]==sfactorAlpha && hard->blend_func[3]==dfactorAlpha)
+        ELIDE("elided glBlendFuncSeparate(%s, %s, %s, %s)\n", PrintEnum(sfactorRGB), PrintEnum(dfactorRGB), PrintEnum(sfactorAlpha), PrintEnum(dfactorAlpha));
+    hard->blend_func[0] = sfactorRGB;
+    hard->blend_func[1] = dfactorRGB;
+    hard->blend_func[2] = sfactorAlpha;
+    hard->blend_func[3] = dfactorAlpha;
+    SENT();
+    real_glBlendFuncSeparate(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+}
+
+static void APIENTRY_GLES hard_glBlendEquation(GLenum mode) {
+    HARD(glBlendEquation, mode);
+    if(hard->blend_eq[0]==mode && hard->blend_eq[1]==mode)
+        ELIDE("elided glBlendEquation(%s)\n", PrintEnum(mode));
+    hard->blend_eq[0] = hard->blend_eq[1] = mode;
+    SENT();
+    real_glBlendEquation(mode);
+}
+
+static void APIENTRY_GLES hard_glBlendEquationSeparate(GLenum modeRGB, GLenum modeA) {
+    HARD(glBlendEquationSeparate, modeRGB, modeA);
+    if(hard->blend_eq[0]==modeRGB && hard->blend_eq[1]==modeA)
+        ELIDE("elided glBlendEquationSeparate(%s, %s)\n", PrintEnum(modeRGB), PrintEnum(modeA));
+    hard->blend_eq[0] = modeRGB;
+    hard->blend_eq[1] = modeA;
+    SENT();
+    real_glBlendEquationSeparate(modeRGB, modeA);
+}
+
+static void APIENTRY_GLES hard_glBlendColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha) {
+    HARD(glBlendColor, red, green, blue, alpha);
+    // unknown is NaN, that never compare equal
+    if(hard->blend_color[0]==red && hard->blend_color[1]==green && hard->blend_color[2]==blue && hard->blend_color[3]==alpha)
+        ELIDE("elided glBlendColor(%f, %f, %f, %f)\n", red, green, blue, alpha);
+    hard->blend_color[0] = red;
+    hard->blend_color[1] = green;
+    hard->blend_color[2] = blue;
+    hard->blend_color[3] = alpha;
+    SENT();
+    real_glBlendColor(red, green, blue, alpha);
+}
+
+static void APIENTRY_GLES hard_glDepthFunc(GLenum func) {
+    HARD(glDepthFunc, func);
+    if(hard->depth_func==func)
+        ELIDE("elided glDepthFunc(%s)\n", PrintEnum(func));
+    hard->depth_func = func;
+    SENT();
+    real_glDepthFunc(func);
+}
+
+static void APIENTRY_GLES hard_glDepthMask(GLboolean flag) {
+    HARD(glDepthMask, flag);
+    GLuint mask = flag?1:0;
+    if(hard->depth_mask==mask)
+        ELIDE("elided glDepthMask(%d)\n", mask);
+    hard->depth_mask = mask;
+    SENT();
+    real_glDepthMask(flag);
+}
+
+static void APIENTRY_GLES hard_glDepthRangef(GLclampf Near, GLclampf Far) {
+    HARD(glDepthRangef, Near, Far);
+    if(hard->depth_range[0]==Near && hard->depth_range[1]==Far)
+        ELIDE("elided glDepthRangef(%f, %f)\n", Near, Far);
+    hard->depth_range[0] = Near;
+    hard->depth_range[1] = Far;
+    SENT();
+    real_glDepthRangef(Near, Far);
+}
+
+static void APIENTRY_GLES hard_glCullFace(GLenum mode) {
+    HARD(glCullFace, mode);
+    if(hard->cull_face==mode)
+        ELIDE("elided glCullFace(%s)\n", PrintEnum(mode));
+    hard->cull_face = mode;
+    SENT();
+    real_glCullFace(mode);
+}
+
+static void APIENTRY_GLES hard_glFrontFace(GLenum mode) {
+    HARD(glFrontFace, mode);
+    if(hard->front_face==mode)
+        ELIDE("elided glFrontFace(%s)\n", PrintEnum(mode));
+    hard->front_face = mode;
+    SENT();
+    real_glFrontFace(mode);
+}
+
+static void APIENTRY_GLES hard_glViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    HARD(glViewport, x, y, width, height);
+    // unknown is a negative size, that is never sent
+    if(hard->viewport[0]==x && hard->viewport[1]==y && hard->viewport[2]==width && hard->viewport[3]==height)
+        ELIDE("elided glViewport(%d, %d, %d, %d)\n", x, y, width, height);
+    hard->viewport[0] = x;
+    hard->viewport[1] = y;
+    hard->viewport[2] = width;
+    hard->viewport[3] = height;
+    SENT();
+    real_glViewport(x, y, width, height);
+}
+
+static void APIENTRY_GLES hard_glScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    HARD(glScissor, x, y, width, height);
+    if(hard->scissor[0]==x && hard->scissor[1]==y && hard->scissor[2]==width && hard->scissor[3]==height)
+        ELIDE("elided glScissor(%d, %d, %d, %d)\n", x, y, width, height);
+    hard->scissor[0] = x;
+    hard->scissor[1] = y;
+    hard->scissor[2] = width;
+    hard->scissor[3] = height;
+    SENT();
+    real_glScissor(x, y, width, height);
+}
+
+static void APIENTRY_GLES hard_glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    HARD(glColorMask, red, green, blue, alpha);
+    GLuint mask = (red?1:0) | (green?2:0) | (blue?4:0) | (alpha?8:0);
+    if(hard->color_mask==mask)
+        ELIDE("elided glColorMask(%d, %d, %d, %d)\n", red, green, blue, alpha);
+    hard->color_mask = mask;
+    SENT();
+    real_glColorMask(red, green, blue, alpha);
+}
+
+static void APIENTRY_GLES hard_glActiveTexture(GLenum texture) {
+    HARD(glActiveTexture, texture);
+    GLuint active = texture - GL_TEXTURE0;
+    if(hard->active==active)
+        ELIDE("elided glActiveTexture(%s)\n", PrintEnum(texture));
+    hard->active = active;
+    SENT();
+    real_glActiveTexture(texture);
+}
+
+static void APIENTRY_GLES hard_glBindTexture(GLenum target, GLuint texture) {
+    HARD(glBindTexture, target, texture);
+    int tgt = tex_target(target);
+    if(tgt>=0 && hard->active<MAX_TEX) {
+        if(hard->texture[hard->active][tgt]==texture)
+            ELIDE("elided glBindTexture(%s, %u) on TMU%u\n", PrintEnum(target), texture, hard->active);
+        hard->texture[hard->active][tgt] = texture;
+    }
+    SENT();
+    real_glBindTexture(target, texture);
+}
+
+static void APIENTRY_GLES hard_glDeleteTextures(GLsizei n, const GLuint *textures) {
+    HARD(glDeleteTextures, n, textures);
+    // deleted textures are unbound from every unit of the driver
+    for (int i=0; i<n; ++i)
+        if(textures[i])
+            for (int j=0; j<MAX_TEX; ++j)
+                for (int k=0; k<HARD_TEX_LAST; ++k)
+                    if(hard->texture[j][k]==textures[i])
+                        hard->texture[j][k] = 0;
+    real_glDeleteTextures(n, textures);
+}
+
+static void APIENTRY_GLES hard_glBindBuffer(GLenum target, GLuint buffer) {
+    HARD(glBindBuffer, target, buffer);
+    int tgt = buf_target(target);
+    if(tgt>=0) {
+        if(hard->buffer[tgt]==buffer)
+            ELIDE("elided glBindBuffer(%s, %u)\n", PrintEnum(target), buffer);
+        hard->buffer[tgt] = buffer;
+    }
+    SENT();
+    real_glBindBuffer(target, buffer);
+}
+
+static void APIENTRY_GLES hard_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
+    HARD(glDeleteBuffers, n, buffers);
+    for (int i=0; i<n; ++i)
+        if(buffers[i])
+            for (int j=0; j<HARD_BUF_LAST; ++j)
+                if(hard->buffer[j]==buffers[i])
+                    hard->buffer[j] = 0;
+    real_glDeleteBuffers(n, buffers);
+}
+
+#undef HARD
+#undef SENT
+#undef ELIDE
+
+typedef struct {
+    const char  *name;
+    void        **real;
+    void        *wrapper;
+} hardstate_proc_t;
+
+#define HOOK(name) {#name, (void**)&real_##name, (void*)hard_##name}
+static const hardstate_proc_t hardstate_procs[] = {
+    HOOK(glEnable),
+    HOOK(glDisable),
+    HOOK(glBlendFunc),
+    HOOK(glBlendFuncSeparate),
+    HOOK(glBlendEquation),
+    HOOK(glBlendEquationSeparate),
+    HOOK(glBlendColor),
+    HOOK(glDepthFunc),
+    HOOK(glDepthMask),
+    HOOK(glDepthRangef),
+    HOOK(glCullFace),
+    HOOK(glFrontFace),
+    HOOK(glViewport),
+    HOOK(glScissor),
+    HOOK(glColorMask),
+    HOOK(glActiveTexture),
+    HOOK(glBindTexture),
+    HOOK(glDeleteTextures),
+    HOOK(glBindBuffer),
+    HOOK(glDeleteBuffers),
+};
+#undef HOOK
+
+void* hardstate_hook(const char *name, void *proc) {
+    if(!proc || name[0]!='g')
+        return proc;
+    for (int i=0; i<sizeof(hardstate_procs)/sizeof(hardstate_procs[0]); ++i)
+        if(!strcmp(hardstate_procs[i].name, name)) {
+            *hardstate_procs[i].real = proc;
+            return hardstate_procs[i].wrapper;
+        }
+    return proc;
+}
@@ -0,0 +1,16 @@
+#ifndef _GL4ES_HARDSTATE_H_
+#define _GL4ES_HARDSTATE_H_
+
+#include "state.h"
+
+// Shadow of the GLES driver state (stored in glstate->gleshard)
+// The state setting functions of the driver are wrapped when loaded (see proc_address),
+// so a call that would not change the driver state is not sent at all.
+// With LIBGL_NOSHADOW=1 the state is still tracked, but every call is sent
+
+// set all the shadowed state to "unknown" (active texture stays GL_TEXTURE0)
+void hardstate_reset(gleshard_t *hard);
+// return the wrapper of the driver function "name" whose real address is proc, or proc if not shadowed
+void* hardstate_hook(const char *name, void *proc);
+
+#endif // _GL4ES_HARDSTATE_H_
@@ -14,15 +14,19 @@
 #include "../../version.h"
 #include "../glx/glx_gbm.h"
 #include "../glx/streaming.h"
+#include "array.h"
 #include "gl4es.h"
 #include "build_info.h"
 #include "debug.h"
+#include "drawmerge.h"
 #include "loader.h"
 #include "logs.h"
 #include "fpe_cache.h"
 #include "init.h"
 #include "envvars.h"
 #include "config.h"
+#include "perflog.h"
+#include "tracer.h"
 
 #if defined(__EMSCRIPTEN__)
 #define NO_INIT_CONSTRUCTOR
@@ -171,6 +175,21 @@ void initialize_gl4es() {
     }
     env(LIBGL_BLITFB0, globals4es.blitfb0, "Blit to FB 0 force a SwapBuffer");
     env(LIBGL_FPS, globals4es.showfps, "fps counter enabled");
+    globals4es.counters = ReturnEnvVarInt("LIBGL_COUNTERS");
+    if(globals4es.counters>0) {
+        SHUT_LOGD("Print internal counters every %d frames\n", globals4es.counters);
+    } else
+        globals4es.counters = 0;
+    globals4es.trace = GetEnvVar("LIBGL_TRACE");
+    if(globals4es.trace && globals4es.trace[0]) {
+        SHUT_LOGD("Writing stutter trace to %s\n", globals4es.trace);
+    } else
+        globals4es.trace = NULL;
+    globals4es.perflog = GetEnvVar("LIBGL_PERFLOG");
+    if(globals4es.perflog && globals4es.perflog[0]) {
+        SHUT_LOGD("Writing per-frame perf log to %s\n", globals4es.perflog);
+    } else
+        globals4es.perflog = NULL;
 #if defined(USE_FBIO) || defined(PYRA)
     env(LIBGL_VSYNC, globals4es.vsync, "vsync enabled");
 #endif
@@ -255,6 +274,20 @@ void initialize_gl4es() {
 #endif
     }
 
+    globals4es.nulldriver = ReturnEnvVarInt("LIBGL_NULLDRIVER");
+    switch(globals4es.nulldriver) {
+      case 0:
+        break;
+      case 2:
+        SHUT_LOGD("Using null GLES driver, with call log (nothing is rendered)\n");
+        break;
+      default:
+        globals4es.nulldriver = 1;
+        SHUT_LOGD("Using null GLES driver (nothing is rendered)\n");
+        break;
+    }
+    env(LIBGL_NOSHADOW, globals4es.noshadow, "Do not shadow the GLES driver state, every state change is sent");
+
 #if !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
     load_libs();
 #endif
@@ -264,6 +297,8 @@ void initialize_gl4es() {
 #else
     int gl4es_notest = IsEnvVarTrue("LIBGL_NOTEST");
 #endif
+    if(globals4es.nulldriver)
+        gl4es_notest = 1;   // only a fake EGL, nothing to test
     env(LIBGL_NOHIGHP, globals4es.nohighp, "Do not use HIGHP in fragment shader even if detected");
 
     globals4es.floattex=ReturnEnvVarIntDef("LIBGL_FLOAT", 1);
@@ -281,6 +316,8 @@ void initialize_gl4es() {
 
     GetHardwareExtensions(gl4es_notest);
 
+    SHUT_LOGD("Using %s index range scans\n", select_indices_scan(1));
+
 #if !defined(NO_LOADER) && !defined(NO_GBM)
     if(globals4es.usegbm)
         LoadGBMFunctions();
@@ -569,6 +606,26 @@ void initialize_gl4es() {
     } else {
         SHUT_LOGD("Trying to batch subsequent glDrawXXXX of size between %d and %d vertices\n", globals4es.minbatch, globals4es.maxbatch);
     }
+    globals4es.drawmerge = ReturnEnvVarIntDef("LIBGL_DRAWMERGE",0);
+    if(globals4es.drawmerge<0) globals4es.drawmerge = 0;
+    if(globals4es.drawmerge>DRAWMERGE_MAXVERTICES) globals4es.drawmerge = DRAWMERGE_MAXVERTICES;
+    if(globals4es.drawmerge)
+        SHUT_LOGD("Merging subsequent client arrays glDrawArrays / glDrawElements of up to %d vertices\n", globals4es.drawmerge);
+    globals4es.listpool = ReturnEnvVarIntDef("LIBGL_LISTPOOL",1);
+    if(!globals4es.listpool)
+        SHUT_LOGD("Renderlists are not recycled\n");
+    globals4es.listopt = ReturnEnvVarIntDef("LIBGL_LISTOPT",1);
+    if(!globals4es.listopt) {
+        SHUT_LOGD("Display lists are not optimized\n");
+    } else if(globals4es.listopt>1) {
+        SHUT_LOGD("Display lists are optimized, with statistics\n");
+    }
+    globals4es.listweld = ReturnEnvVarIntDef("LIBGL_LISTWELD",1);
+    if(!globals4es.listweld) {
+        SHUT_LOGD("Display lists vertices are not welded\n");
+    } else if(globals4es.listweld>1) {
+        SHUT_LOGD("Display lists vertices are welded, and triangles reordered for the vertex cache\n");
+    }
 
     if(hardext.esversion==1) globals4es.usevbo=0;   // VBO on ES1.1 backend will be too messy, so disabling
     else {
@@ -590,6 +647,18 @@ void initialize_gl4es() {
               globals4es.usevbo=1;
               break;
         }
+        if(globals4es.usevbo) {
+            globals4es.streamvbo = ReturnEnvVarIntDef("LIBGL_STREAMVBO",4);
+            if(globals4es.streamvbo<0) globals4es.streamvbo = 0;
+            if(globals4es.streamvbo)
+                SHUT_LOGD("Streaming client arrays in a %dMB VBO\n", globals4es.streamvbo);
+            globals4es.compactlist = ReturnEnvVarIntDef("LIBGL_COMPACTLIST",1);
+            if(!globals4es.compactlist)
+                SHUT_LOGD("Display lists VBO use full float attributes\n");
+            globals4es.listvbo = ReturnEnvVarIntDef("LIBGL_LISTVBO",1);
+            if(!globals4es.listvbo)
+                SHUT_LOGD("Each display list has its own VBO\n");
+        }
       }
 
     globals4es.fbomakecurrent = 0;
@@ -729,6 +798,12 @@ void initialize_gl4es() {
     if(hardext.shader_fbfetch) {
       env(LIBGL_SHADERBLEND, globals4es.shaderblend, "Blend will be handled in shaders");
     }
+    if(hardext.esversion>2) {
+      env(LIBGL_NOHARDVAO, globals4es.nohardvao, "Don't use native vertex arrays objects");
+    }
+    if(hardext.esversion>2 && hardext.glsl300es) {
+      env(LIBGL_FPE_UBO, globals4es.fpeubo, "Fixed pipeline builtins shared in a uniform buffer");
+    }
     if(hardext.prgbin_n>0 && !globals4es.notexarray) {
         env(LIBGL_NOPSA, globals4es.nopsa, "Don't use PrecompiledShaderArchive");
         if(globals4es.nopsa==0) {
@@ -790,6 +865,8 @@ void close_gl4es() {
     FreeFBVisual();
     #endif
     gl_close();
+    perflog_close();
+    tracer_close();
     fpe_writePSA();
     fpe_FreePSA();
         #if defined(GL4ES_COMPILE_FOR_USE_IN_SHARED_LIB) && defined(AMIGAOS4)
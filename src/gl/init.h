@@ -48,10 +48,17 @@ typedef struct _globals4es {
     int nohighp;
     int minbatch;
     int maxbatch;
+    int drawmerge;         // max vertices of a client arrays draw merged with the next ones (0 to disable)
+    int listpool;          // recycle renderlists and their arrays
+    int listopt;           // optimize display lists at glEndList (2 to also log the statistics)
+    int listweld;          // weld the duplicate vertices of display lists (2 to also reorder the triangles for the vertex cache)
     int es;
     unsigned int esversion;
     int gl;
     int usevbo;
+    int streamvbo;         // size in MB of the ring VBO for client arrays (0 to disable)
+    int compactlist;       // display lists VBO use compact attribute formats
+    int listvbo;           // display lists arrays and indices are sub-allocated in pooled VBO
     int comments;
     int forcenpot;
     int fbomakecurrent;    // hack to bind/unbind FBO when doing glXMakeCurrent
@@ -77,6 +84,8 @@ typedef struct _globals4es {
     int blitfb0;
     int skiptexcopies;
     int shaderblend;
+    int fpeubo;
+    int nohardvao;
     int deepbind;
     float fbtexscale;
     #ifndef NO_GBM
@@ -92,6 +101,11 @@ typedef struct _globals4es {
     int force_es_copy_tex;
     const char *force_egl_lib;
     const char *force_gles_lib;
+    int nulldriver;        // use the built-in null GLES driver (1=counters, 2=counters+call log)
+    const char *perflog;   // file to write the per-frame perf log to
+    int counters;          // print the internal counters every N frames (0=never)
+    const char *trace;     // file to write the stutter trace to
+    int noshadow;          // do not shadow the GLES driver state (every state change is sent)
 } globals4es_t;
 
 extern globals4es_t globals4es;
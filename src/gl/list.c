@@ -5,6 +5,7 @@
 #include "gl4es.h"
 #include "glstate.h"
 #include "init.h"
+#include "listweld.h"
 #include "loader.h"
 #include "buffers.h"
 
@@ -17,9 +18,10 @@ KHASH_MAP_IMPL_INT(gllisthead, renderlist_t*);
 
 renderlist_t *alloc_renderlist() {
 
-    renderlist_t *list = (renderlist_t *)malloc(sizeof(renderlist_t));
+    renderlist_t *list = listpool_getlist();
     memset(list, 0, sizeof(renderlist_t));
     list->cap = DEFAULT_RENDER_LIST_CAPACITY;
+    list->pooled_arrays = 1;
     list->matrix_val[0] = list->matrix_val[5] = list->matrix_val[10] = 
                           list->matrix_val[15] = 1.0f;
     list->lightmodelparam = GL_LIGHT_MODEL_AMBIENT;
@@ -252,8 +254,10 @@ void renderlist_quads2triangles(renderlist_t *a) {
         }
         resize_merger_indices(ilen);
         a->indices = glstate->merger_indices;
-    } else
-        a->indices = (GLushort*)malloc(ilen*sizeof(GLushort));
+    } else {
+        a->indices = (GLushort*)listpool_alloc(ilen*sizeof(GLushort));
+        a->indice_cap = listpool_blocksize(ilen*sizeof(GLushort))/sizeof(GLushort);
+    }
 
     for (int i=0, j=0; i+3<len; i+=4, j+=6) {
         a->indices[j+0] = vind(i+0);
@@ -267,7 +271,7 @@ void renderlist_quads2triangles(renderlist_t *a) {
     a->ilen = ilen;
     if (ind) {
         if (!a->shared_indices || ((*a->shared_indices)--)==0)  {
-            free(ind); 
+            listpool_free(ind, len*sizeof(GLushort));
             free(a->shared_indices);
         }
         a->shared_indices = NULL; // unshared list
@@ -324,8 +328,8 @@ int mode_needindices(GLenum m) {
 
 void list_add_modeinit(renderlist_t* list, GLenum mode) {
     if (list->mode_init_len+1 >= list->mode_init_cap) {
-        list->mode_init_cap+=128;
-        list->mode_inits = (modeinit_t*)realloc(list->mode_inits, list->mode_init_cap*sizeof(modeinit_t));
+        list->mode_inits = (modeinit_t*)listpool_realloc(list->mode_inits, (list->mode_init_cap+128)*sizeof(modeinit_t));
+        list->mode_init_cap = listpool_blocksize((list->mode_init_cap+128)*sizeof(modeinit_t))/sizeof(modeinit_t);
     }
     list->mode_inits[list->mode_init_len].mode_init = mode;
     list->mode_inits[list->mode_init_len++].ilen = list->indices?list->ilen:(list->cur_istart?list->cur_istart:list->len);
@@ -334,6 +338,7 @@ void list_add_modeinit(renderlist_t* list, GLenum mode) {
 void unshared_renderlist(renderlist_t *a, int cap) {
     if(a->shared_arrays && ((*a->shared_arrays)--)>0) {
         a->cap = cap;
+        a->pooled_arrays = 1;
         GLfloat *tmp;
         tmp = a->vert;
         if (tmp) {
@@ -381,7 +386,8 @@ void unsharedindices_renderlist(renderlist_t* a, int cap)
             GLushort* tmpi = a->indices;
             a->indice_cap = cap;
             if (a->indice_cap > 48) a->indice_cap = ((a->indice_cap+512)>>9)<<9;
-            a->indices = (GLushort*)malloc(a->indice_cap*sizeof(GLushort));
+            a->indices = (GLushort*)listpool_alloc(a->indice_cap*sizeof(GLushort));
+            a->indice_cap = listpool_blocksize(a->indice_cap*sizeof(GLushort))/sizeof(GLushort);
             memcpy(a->indices, tmpi, a->ilen*sizeof(GLushort));
         }
     } 
@@ -409,10 +415,11 @@ void prepareadd_renderlist(renderlist_t* a, int size_to_add)
     // alloc or realloc a->indices first...
     int capindices = renderlist_getindicesize(a)+size_to_add;
     if (capindices > 48) capindices = ((capindices+512)>>9)<<9;
+    capindices = listpool_blocksize(capindices*sizeof(GLushort))/sizeof(GLushort);
     #define alloc_a_indices                                      \
-    newind=(GLushort*)malloc(capindices*sizeof(GLushort))
+    newind=(GLushort*)listpool_alloc(capindices*sizeof(GLushort))
     #define copy_a_indices                                       \
-    if (a->indices) free(a->indices);                            \
+    if (a->indices) listpool_free(a->indices, a->indice_cap*sizeof(GLushort)); \
     a->indices = newind;                                         \
     a->indice_cap = capindices
     // check if "a" needs to be converted
@@ -460,7 +467,7 @@ void prepareadd_renderlist(renderlist_t* a, int size_to_add)
             } else {
                 // a->indices already exist, just check if need to adjust its size
                 if (a->indice_cap < capindices) {
-                    a->indices = (GLushort*)realloc(a->indices, capindices*sizeof(GLushort));
+                    a->indices = (GLushort*)listpool_realloc(a->indices, capindices*sizeof(GLushort));
                     a->indice_cap = capindices;
                 }
             }
@@ -623,14 +630,31 @@ renderlist_t* append_calllist(renderlist_t *list, renderlist_t *a)
             new->prev = list;
             // ok, now on new list
             list = new;
+            // the VBO stay owned by "a", the copy will make its own if needed
+            if (list->vbo_array) {
+                list->vbo_array = 0;
+                list->vbo_array_offset = list->vbo_array_size = 0;
+                list->use_vbo_array = 0;
+                memset(&list->vbo_vert_fmt, 0, sizeof(listvbofmt_t));
+                memset(&list->vbo_normal_fmt, 0, sizeof(listvbofmt_t));
+                memset(&list->vbo_color_fmt, 0, sizeof(listvbofmt_t));
+                memset(&list->vbo_secondary_fmt, 0, sizeof(listvbofmt_t));
+                memset(&list->vbo_fogcoord_fmt, 0, sizeof(listvbofmt_t));
+                memset(list->vbo_tex_fmt, 0, sizeof(list->vbo_tex_fmt));
+            }
+            if (list->vbo_indices) {
+                list->vbo_indices = 0;
+                list->vbo_indices_offset = list->vbo_indices_size = 0;
+                list->use_vbo_indices = 0;
+            }
+            list->listvbo = NULL;
+            if (list->mode_inits) {
+                list->mode_inits = (modeinit_t*)listpool_alloc(a->mode_init_cap*sizeof(modeinit_t));
+                memcpy(list->mode_inits, a->mode_inits, a->mode_init_len*sizeof(modeinit_t));
+            }
             // copy the many list arrays
             if (list->calls.len > 0) {
                 ++(*list->shared_calls);
-                /*
-                list->calls.calls = (packed_call_t**)malloc(sizeof(packed_call_t*)*a->calls.cap);
-                for (int i = 0; i < list->calls.len; i++) {
-                    list->calls.calls[i] = glCopyPackedCall(a->calls.calls[i]);
-                }*/
             }
             if(list->len) {
                 ++(*list->shared_arrays);
@@ -681,30 +705,29 @@ void free_renderlist(renderlist_t *list) {
     renderlist_t *next;
     do {
         if(list->mode_inits)
-            free(list->mode_inits);
+            listpool_free(list->mode_inits, list->mode_init_cap*sizeof(modeinit_t));
         if ((list->calls.len > 0) && (!list->shared_calls || ((*list->shared_calls)--)==0)) {
             if(list->shared_calls) free(list->shared_calls);
-            for (int i = 0; i < list->calls.len; i++) {
-                free(list->calls.calls[i]);
-            }
-            free(list->calls.calls);
+            listpool_free(list->calls.data, list->calls.cap);
         }
         int a;
         if(!list->use_glstate) {
             if (!list->shared_arrays || ((*list->shared_arrays)--)==0) {
                 if (list->shared_arrays) free(list->shared_arrays);
-                if (list->vert) free(list->vert);
-                if (list->normal) free(list->normal);
-                if (list->color) free(list->color);
-                if (list->secondary) free(list->secondary);
-                if (list->fogcoord) free(list->fogcoord);
+                // give the arrays back to the pool
+                #define GO(A, N) listpool_free(A, (list->pooled_arrays)?listpool_blocksize(N*sizeof(GLfloat)*list->cap):(N*sizeof(GLfloat)*list->cap))
+                GO(list->vert, 4);
+                GO(list->normal, 3);
+                GO(list->color, 4);
+                GO(list->secondary, 4);
+                GO(list->fogcoord, 1);
                 for (a=0; a<list->maxtex; a++)
-                    if (list->tex[a]) free(list->tex[a]);
+                    GO(list->tex[a], 4);
+                #undef GO
             }
             if (!list->shared_indices || ((*list->shared_indices)--)==0) {
                 if (list->shared_indices) free(list->shared_indices);
-                if (list->indices)
-                    free(list->indices);
+                listpool_free(list->indices, list->indice_cap*sizeof(GLushort));
             }
         } else
             glstate->merger_used = 0;
@@ -760,13 +783,17 @@ void free_renderlist(renderlist_t *list) {
             free(list->ind_lines);
         if(list->final_colors)
             free(list->final_colors);
-        if(list->vbo_array)
+        if(list->vbo_array_size)
+            listvbo_free(list->listvbo, LISTVBO_ARRAYS, list->vbo_array, list->vbo_array_offset, list->vbo_array_size);
+        else if(list->vbo_array)
             deleteSingleBuffer(list->vbo_array);
-        if(list->vbo_indices)
+        if(list->vbo_indices_size)
+            listvbo_free(list->listvbo, LISTVBO_INDICES, list->vbo_indices, list->vbo_indices_offset, list->vbo_indices_size);
+        else if(list->vbo_indices)
             deleteSingleBuffer(list->vbo_indices);
 
         next = list->next;
-        free(list);
+        listpool_putlist(list);
     } while ((list = next));
 }
 
@@ -819,7 +846,8 @@ void resize_indices_renderlist(renderlist_t *list, int n) {
         if(list->ilen+n<list->indice_cap)
             return;
         list->indice_cap = ((list->indice_cap+n+511)>>9)<<9;
-        list->indices = (GLushort*)realloc(list->indices, list->indice_cap*sizeof(GLushort));
+        list->indices = (GLushort*)listpool_realloc(list->indices, list->indice_cap*sizeof(GLushort));
+        list->indice_cap = listpool_blocksize(list->indice_cap*sizeof(GLushort))/sizeof(GLushort);
     }
 }
 
@@ -864,6 +892,9 @@ renderlist_t* end_renderlist(renderlist_t *list) {
             list->mode = GL_TRIANGLE_STRIP;
             break;
     }
+    // display lists are drawn many times, weld their vertices
+    if(list->name && globals4es.listweld)
+        listweld_renderlist(list);
     if(list->prev && isempty_renderlist(list)) {
         renderlist_t *p = list;
         list = list->prev;
@@ -906,7 +937,8 @@ renderlist_t* recycle_renderlist(renderlist_t *list, GLenum mode) {
                 resize_merger_indices(renderlist_getindicesize(list)); indices = glstate->merger_indices;\
             } else {\
                 list->indice_cap = renderlist_getindicesize(list);\
-                indices = (GLushort*)malloc(sizeof(GLushort)*list->indice_cap);\
+                indices = (GLushort*)listpool_alloc(sizeof(GLushort)*list->indice_cap);\
+                list->indice_cap = listpool_blocksize(sizeof(GLushort)*list->indice_cap)/sizeof(GLushort);\
             }
 #define post_expand  \
             list->ilen = renderlist_getindicesize(list);\
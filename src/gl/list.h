@@ -2,11 +2,14 @@
 #define _GL4ES_LIST_H_
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "khash.h"
 #include "../config.h"
 #include "wrap/gles.h"
 #include "attributes.h"
 #include "gles.h"
+#include "listpool.h"
+#include "listvbo.h"
 
 typedef enum {
 	STAGE_NONE = 0,
@@ -109,12 +112,22 @@ KHASH_MAP_DECLARE_INT(light, renderlight_t *);
 KHASH_MAP_DECLARE_INT(texgen, rendertexgen_t *);
 KHASH_MAP_DECLARE_INT(texenv, rendertexenv_t *);
 
+// the packed calls of a list, stored one after the other in 1 buffer: each one is prefixed by
+// its size (callhead_t) and padded to a multiple of 8 bytes, so the packed args stay aligned
 typedef struct _call_list_t {
-    unsigned long len;
-    unsigned long cap;
-    packed_call_t **calls;
+    unsigned long len;      // number of calls
+    unsigned long size;     // bytes used in data
+    unsigned long cap;      // bytes allocated for data
+    char *data;
 } call_list_t;
 
+typedef struct {
+    uint64_t size;          // size of the call, including this head
+} callhead_t;
+
+#define CALLHEAD(p)     ((callhead_t*)(p))
+#define CALLPACKED(p)   ((packed_call_t*)((char*)(p)+sizeof(callhead_t)))
+
 typedef struct {
 	GLsizei width;
 	GLsizei height;
@@ -137,6 +150,14 @@ typedef struct {
     int    ilen;
 } modeinit_t;
 
+// format of an array in the VBO of a list, when list2VBO compacted it (size is 0 if the array is uploaded as is)
+typedef struct {
+    GLint       size;
+    GLenum      type;
+    GLboolean   normalized;
+    GLsizei     stride;
+} listvbofmt_t;
+
 typedef struct _renderlist_t {
     unsigned long len;
     unsigned long ilen;
@@ -160,6 +181,7 @@ typedef struct _renderlist_t {
     call_list_t calls;
     
     int *shared_arrays;
+    int  pooled_arrays;     // arrays are from alloc_sublist: they hold listpool_blocksize(n*cap) bytes
     GLfloat *vert;
     GLfloat *normal;
     GLfloat *color;
@@ -174,6 +196,11 @@ typedef struct _renderlist_t {
     int      tex_stride[MAX_TEX];
     GLuint   vbo_array;
     GLuint   vbo_indices;
+    GLuint   vbo_array_offset;      // arrays sub-allocated in a pooled VBO (see listvbo.h), vbo_array_size is 0 if vbo_array is their own VBO
+    GLuint   vbo_array_size;
+    GLuint   vbo_indices_offset;    // same for the indices
+    GLuint   vbo_indices_size;
+    struct listvbo_s *listvbo;      // pool of the sub-allocated arrays / indices
     int      use_vbo_array;   // 0=Not evaluated, 1=No, 2=Yes
     int      use_vbo_indices; // same
     GLfloat *vbo_vert;
@@ -182,6 +209,12 @@ typedef struct _renderlist_t {
     GLfloat *vbo_secondary;
     GLfloat *vbo_fogcoord;
     GLfloat *vbo_tex[MAX_TEX];
+    listvbofmt_t vbo_vert_fmt;
+    listvbofmt_t vbo_normal_fmt;
+    listvbofmt_t vbo_color_fmt;
+    listvbofmt_t vbo_secondary_fmt;
+    listvbofmt_t vbo_fogcoord_fmt;
+    listvbofmt_t vbo_tex_fmt[MAX_TEX];
     int *shared_indices;
     GLushort *indices;
     unsigned int indice_cap;
@@ -248,7 +281,7 @@ typedef struct _renderlist_t {
 
 KHASH_MAP_DECLARE_INT(gllisthead, renderlist_t*);
 
-#define DEFAULT_CALL_LIST_CAPACITY 20
+#define DEFAULT_CALL_LIST_CAPACITY 512    // in bytes
 #define DEFAULT_RENDER_LIST_CAPACITY 64
 
 int rendermode_dimensions(GLenum mode);
@@ -260,11 +293,11 @@ renderlist_t* NewDrawStage(renderlist_t* l, GLenum m);
 renderlist_t* GetFirst(renderlist_t* list);
 
 #define alloc_sublist(n, cap) \
-    (GLfloat *)malloc(n * sizeof(GLfloat) * cap)
+    (GLfloat *)listpool_alloc(n * sizeof(GLfloat) * cap)
 
 #define realloc_sublist(ref, n, cap) \
     if (ref)                         \
-        ref = (GLfloat *)realloc(ref, n * sizeof(GLfloat) * cap)
+        ref = (GLfloat *)listpool_realloc(ref, n * sizeof(GLfloat) * cap)
 
 #define realloc_merger_sublist(ref, n, cap) \
         ref = (GLfloat *)realloc(ref, n * sizeof(GLfloat) * cap)
@@ -275,6 +308,9 @@ void free_renderlist(renderlist_t *list);
 void draw_renderlist(renderlist_t *list);
 renderlist_t* end_renderlist(renderlist_t *list);
 bool isempty_renderlist(renderlist_t *list);
+bool ispurerender_renderlist(renderlist_t *list);
+bool islistscompatible_renderlist(renderlist_t *a, renderlist_t *b);
+void append_renderlist(renderlist_t *a, renderlist_t *b);
 void resize_renderlist(renderlist_t *list);
 renderlist_t *alloc_renderlist();
 int mode_needindices(GLenum m);
@@ -306,7 +342,7 @@ void rlTexEnvfv(renderlist_t *list, GLenum target, GLenum pname, const GLfloat *
 void rlTexEnviv(renderlist_t *list, GLenum target, GLenum pname, const GLint * params);
 void rlNormal3f(renderlist_t *list, GLfloat x, GLfloat y, GLfloat z) FASTMATH;
 void rlNormal3fv(renderlist_t *list, GLfloat* v) FASTMATH;
-void rlPushCall(renderlist_t *list, packed_call_t *data);
+void* rlPushCall(renderlist_t *list, int size);
 void rlMultiTexCoord4f(renderlist_t *list, GLenum texture, GLfloat s, GLfloat t, GLfloat r, GLfloat q) FASTMATH;
 void rlMultiTexCoord2fv(renderlist_t *list, GLenum texture, GLfloat* v) FASTMATH;
 void rlMultiTexCoord4fv(renderlist_t *list, GLenum texture, GLfloat* v) FASTMATH;
@@ -10,6 +10,7 @@
 #include "matrix.h"
 #include "texgen.h"
 #include "render.h"
+#include "tracer.h"
 #include "fpe.h"
 
 /* return 1 if failed, 2 if succeed */
@@ -21,11 +22,182 @@ typedef struct array2vbo_s {
     uintptr_t   vbo_basebase;
 } array2vbo_t;
 
+// compact formats of the list arrays in their VBO
+enum {
+    COMPACT_VERTEX = 0,
+    COMPACT_COLOR,
+    COMPACT_NORMAL,
+    COMPACT_TEXCOORD,
+    COMPACT_FOGCOORD
+};
+
+typedef struct compact2vbo_s {
+    const GLfloat*  array;
+    int             stride;     // in GLfloat
+    int             kind;
+    listvbofmt_t    fmt;        // stride is the size of 1 element until the arrays are interleaved
+    int             offset;     // in the interleaved vertex
+    listvbofmt_t*   list_fmt;
+    GLfloat**       list_vbo;
+} compact2vbo_t;
+
+// float format of the array, packed
+static void floatFormat(compact2vbo_t* c)
+{
+    const int comps = (c->kind==COMPACT_NORMAL)?3:((c->kind==COMPACT_FOGCOORD)?1:4);
+    c->fmt.size = comps;
+    c->fmt.type = GL_FLOAT;
+    c->fmt.normalized = GL_FALSE;
+    c->fmt.stride = comps*sizeof(GLfloat);
+}
+
+// choose the smallest format that keeps the values of the array, return 1 if it is smaller than the float one
+static int compactFormat(compact2vbo_t* c, int len)
+{
+    const GLfloat* p = c->array;
+    floatFormat(c);
+    switch(c->kind) {
+        case COMPACT_VERTEX:
+        case COMPACT_TEXCOORD: {
+            // (x, y, z, 1) => 3 components, (x, y, 0, 1) => 2 components
+            int size = 2;
+            for (int i=0; i<len; ++i, p+=c->stride) {
+                if(p[3]!=1.0f)
+                    return 0;
+                if(p[2]!=0.0f)
+                    size = 3;
+            }
+            c->fmt.size = size;
+            c->fmt.stride = size*sizeof(GLfloat);
+            return 1;
+        }
+        case COMPACT_COLOR:
+            // RGBA8, if all components are in [0, 1] (the negated test also catch NaN)
+            for (int i=0; i<len; ++i, p+=c->stride)
+                for (int j=0; j<4; ++j)
+                    if(!(p[j]>=0.0f && p[j]<=1.0f))
+                        return 0;
+            c->fmt.type = GL_UNSIGNED_BYTE;
+            c->fmt.normalized = GL_TRUE;
+            c->fmt.stride = 4;
+            return 1;
+        case COMPACT_NORMAL:
+            // normalized shorts (padded to 8 bytes), if all components are in [-1, 1]
+            for (int i=0; i<len; ++i, p+=c->stride)
+                for (int j=0; j<3; ++j)
+                    if(!(p[j]>=-1.0f && p[j]<=1.0f))
+                        return 0;
+            c->fmt.type = GL_SHORT;
+            c->fmt.normalized = GL_TRUE;
+            c->fmt.stride = 4*sizeof(GLshort);
+            return 1;
+    }
+    return 0;
+}
+
+static void compactArray(const compact2vbo_t* c, int len, char* dst, int stride)
+{
+    const GLfloat* p = c->array;
+    const int size = c->fmt.size;
+    for (int i=0; i<len; ++i, p+=c->stride, dst+=stride) {
+        switch(c->fmt.type) {
+            case GL_FLOAT:
+                memcpy(dst, p, size*sizeof(GLfloat));
+                break;
+            case GL_UNSIGNED_BYTE:
+                for (int j=0; j<size; ++j)
+                    ((GLubyte*)dst)[j] = (GLubyte)(p[j]*255.0f+0.5f);
+                break;
+            case GL_SHORT:
+                for (int j=0; j<size; ++j)
+                    ((GLshort*)dst)[j] = (GLshort)(p[j]*32767.0f+((p[j]<0.0f)?-0.5f:0.5f));
+                ((GLshort*)dst)[size] = 0;
+                break;
+        }
+    }
+}
+
+/* interleave the arrays (in compact formats if LIBGL_COMPACTLIST) in 1 VBO, pooled if LIBGL_LISTVBO. return 2 */
+static int list2VBOInterleaved(renderlist_t* list)
+{
+    LOAD_GLES2(glGenBuffers);
+    LOAD_GLES2(glBufferData);
+    compact2vbo_t work[5+MAX_TEX];
+    int imax = 0;
+    int len = list->len;
+    #define GO(A, K, C) \
+    work[imax].array = list->A; \
+    work[imax].stride = (list->A##_stride)?list->A##_stride/sizeof(GLfloat):(C); \
+    work[imax].kind = K; \
+    work[imax].list_fmt = &list->vbo_##A##_fmt; \
+    work[imax].list_vbo = &list->vbo_##A; \
+    imax++
+    if(list->vert) {
+        GO(vert, COMPACT_VERTEX, 4);
+    }
+    if(list->color) {
+        GO(color, COMPACT_COLOR, 4);
+    }
+    if(list->secondary) {
+        GO(secondary, COMPACT_COLOR, 4);
+    }
+    if(list->fogcoord) {
+        GO(fogcoord, COMPACT_FOGCOORD, 1);
+    }
+    if(list->normal) {
+        GO(normal, COMPACT_NORMAL, 3);
+    }
+    #undef GO
+    for (int a=0; a<list->maxtex; ++a) {
+        if(list->tex[a]) {
+            work[imax].array = list->tex[a];
+            work[imax].stride = (list->tex_stride[a])?list->tex_stride[a]/sizeof(GLfloat):4;
+            work[imax].kind = COMPACT_TEXCOORD;
+            work[imax].list_fmt = &list->vbo_tex_fmt[a];
+            work[imax].list_vbo = &list->vbo_tex[a];
+            imax++;
+        }
+    }
+    // interleaved vertex (all element sizes are multiple of 4, so every attribute stays aligned)
+    int stride = 0;
+    for (int i=0; i<imax; ++i) {
+        if(globals4es.compactlist)
+            compactFormat(work+i, len);
+        else
+            floatFormat(work+i);
+        work[i].offset = stride;
+        stride += work[i].fmt.stride;
+    }
+    GLuint vbo_size = stride*len;
+    char* data = (char*)malloc(vbo_size);
+    for (int i=0; i<imax; ++i) {
+        compactArray(work+i, len, data+work[i].offset, stride);
+        work[i].fmt.stride = stride;
+    }
+    GLuint offset = 0;
+    if(listvbo_alloc(LISTVBO_ARRAYS, vbo_size, data, &list->listvbo, &list->vbo_array, &offset)) {
+        list->vbo_array_offset = offset;
+        list->vbo_array_size = vbo_size;
+    } else {
+        gles_glGenBuffers(1, &list->vbo_array);
+        bindBuffer(GL_ARRAY_BUFFER, list->vbo_array);
+        gles_glBufferData(GL_ARRAY_BUFFER, vbo_size, data, GL_STATIC_DRAW);
+    }
+    free(data);
+    for (int i=0; i<imax; ++i) {
+        *work[i].list_fmt = work[i].fmt;
+        *work[i].list_vbo = (GLfloat*)(uintptr_t)(offset+work[i].offset);
+    }
+    return 2;
+}
+
 int list2VBO(renderlist_t* list)
 {
     LOAD_GLES2(glGenBuffers);
     LOAD_GLES2(glBufferData);
     LOAD_GLES2(glBufferSubData);
+    if((globals4es.compactlist || globals4es.listvbo) && list->len)
+        return list2VBOInterleaved(list);
     array2vbo_t work[ATT_MAX] = {0};
     // list -> work
     int imax = 0;
@@ -151,93 +323,72 @@ typedef struct save_vbo_s {
     GLuint          real_buffer;
     const GLvoid*   real_pointer;
     glbuffer_t*     buffer;
+    GLint           size;
+    GLenum          type;
+    int             normalized;
+    GLsizei         stride;
 } save_vbo_t;
 
-void listActiveVBO(renderlist_t* list, save_vbo_t* saved) {
-    if(list->vert) {
-        saved[ATT_VERTEX].real_buffer = glstate->vao->vertexattrib[ATT_VERTEX].real_buffer;
-        saved[ATT_VERTEX].real_pointer = glstate->vao->vertexattrib[ATT_VERTEX].real_pointer;
-        saved[ATT_VERTEX].buffer = glstate->vao->vertexattrib[ATT_VERTEX].buffer;
-        glstate->vao->vertexattrib[ATT_VERTEX].real_buffer = list->vbo_array;
-        glstate->vao->vertexattrib[ATT_VERTEX].real_pointer = list->vbo_vert;
-        glstate->vao->vertexattrib[ATT_VERTEX].buffer = NULL;
-    }
-    if(list->color) {
-        saved[ATT_COLOR].real_buffer = glstate->vao->vertexattrib[ATT_COLOR].real_buffer;
-        saved[ATT_COLOR].real_pointer = glstate->vao->vertexattrib[ATT_COLOR].real_pointer;
-        saved[ATT_COLOR].buffer = glstate->vao->vertexattrib[ATT_COLOR].buffer;
-        glstate->vao->vertexattrib[ATT_COLOR].real_buffer = list->vbo_array;
-        glstate->vao->vertexattrib[ATT_COLOR].real_pointer = list->vbo_color;
-        glstate->vao->vertexattrib[ATT_COLOR].buffer = NULL;
-    }
-    if(list->secondary) {
-        saved[ATT_SECONDARY].real_buffer = glstate->vao->vertexattrib[ATT_SECONDARY].real_buffer;
-        saved[ATT_SECONDARY].real_pointer = glstate->vao->vertexattrib[ATT_SECONDARY].real_pointer;
-        saved[ATT_SECONDARY].buffer = glstate->vao->vertexattrib[ATT_SECONDARY].buffer;
-        glstate->vao->vertexattrib[ATT_SECONDARY].real_buffer = list->vbo_array;
-        glstate->vao->vertexattrib[ATT_SECONDARY].real_pointer = list->vbo_secondary;
-        glstate->vao->vertexattrib[ATT_SECONDARY].buffer = NULL;
-    }
-    if(list->fogcoord) {
-        saved[ATT_FOGCOORD].real_buffer = glstate->vao->vertexattrib[ATT_FOGCOORD].real_buffer;
-        saved[ATT_FOGCOORD].real_pointer = glstate->vao->vertexattrib[ATT_FOGCOORD].real_pointer;
-        saved[ATT_FOGCOORD].buffer = glstate->vao->vertexattrib[ATT_FOGCOORD].buffer;
-        glstate->vao->vertexattrib[ATT_FOGCOORD].real_buffer = list->vbo_array;
-        glstate->vao->vertexattrib[ATT_FOGCOORD].real_pointer = list->vbo_fogcoord;
-        glstate->vao->vertexattrib[ATT_FOGCOORD].buffer = NULL;
-    }
-    if(list->normal) {
-        saved[ATT_NORMAL].real_buffer = glstate->vao->vertexattrib[ATT_NORMAL].real_buffer;
-        saved[ATT_NORMAL].real_pointer = glstate->vao->vertexattrib[ATT_NORMAL].real_pointer;
-        saved[ATT_NORMAL].buffer = glstate->vao->vertexattrib[ATT_NORMAL].buffer;
-        glstate->vao->vertexattrib[ATT_NORMAL].real_buffer = list->vbo_array;
-        glstate->vao->vertexattrib[ATT_NORMAL].real_pointer = list->vbo_normal;
-        glstate->vao->vertexattrib[ATT_NORMAL].buffer = NULL;
-    }
-    for (int a=0; a<list->maxtex; ++a) {
-        if(list->tex[a]) {
-            saved[ATT_MULTITEXCOORD0+a].real_buffer = glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].real_buffer;
-            saved[ATT_MULTITEXCOORD0+a].real_pointer = glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].real_pointer;
-            saved[ATT_MULTITEXCOORD0+a].buffer = glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].buffer;
-            glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].real_buffer = list->vbo_array;
-            glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].real_pointer = list->vbo_tex[a];
-            glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].buffer = NULL;
-        }
+static void activeVBO(renderlist_t* list, int att, GLfloat* vbo, listvbofmt_t* fmt, save_vbo_t* saved) {
+    vertexattrib_t *w = &glstate->vao->vertexattrib[att];
+    saved[att].real_buffer = w->real_buffer;
+    saved[att].real_pointer = w->real_pointer;
+    saved[att].buffer = w->buffer;
+    saved[att].size = w->size;
+    saved[att].type = w->type;
+    saved[att].normalized = w->normalized;
+    saved[att].stride = w->stride;
+    w->real_buffer = list->vbo_array;
+    w->real_pointer = vbo;
+    w->buffer = NULL;
+    if(fmt->size) {
+        // compacted by list2VBO
+        w->size = fmt->size;
+        w->type = fmt->type;
+        w->normalized = fmt->normalized;
+        w->stride = fmt->stride;
     }
 }
+static void inactiveVBO(int att, save_vbo_t* saved) {
+    vertexattrib_t *w = &glstate->vao->vertexattrib[att];
+    w->real_buffer = saved[att].real_buffer;
+    w->real_pointer = saved[att].real_pointer;
+    w->buffer = saved[att].buffer;
+    w->size = saved[att].size;
+    w->type = saved[att].type;
+    w->normalized = saved[att].normalized;
+    w->stride = saved[att].stride;
+}
+
+void listActiveVBO(renderlist_t* list, save_vbo_t* saved) {
+    if(list->vert)
+        activeVBO(list, ATT_VERTEX, list->vbo_vert, &list->vbo_vert_fmt, saved);
+    if(list->color)
+        activeVBO(list, ATT_COLOR, list->vbo_color, &list->vbo_color_fmt, saved);
+    if(list->secondary)
+        activeVBO(list, ATT_SECONDARY, list->vbo_secondary, &list->vbo_secondary_fmt, saved);
+    if(list->fogcoord)
+        activeVBO(list, ATT_FOGCOORD, list->vbo_fogcoord, &list->vbo_fogcoord_fmt, saved);
+    if(list->normal)
+        activeVBO(list, ATT_NORMAL, list->vbo_normal, &list->vbo_normal_fmt, saved);
+    for (int a=0; a<list->maxtex; ++a)
+        if(list->tex[a])
+            activeVBO(list, ATT_MULTITEXCOORD0+a, list->vbo_tex[a], &list->vbo_tex_fmt[a], saved);
+}
 void listInactiveVBO(renderlist_t* list, save_vbo_t* saved) {
-    if(list->vert) {
-        glstate->vao->vertexattrib[ATT_VERTEX].real_buffer = saved[ATT_VERTEX].real_buffer;
-        glstate->vao->vertexattrib[ATT_VERTEX].real_pointer = saved[ATT_VERTEX].real_pointer;
-        glstate->vao->vertexattrib[ATT_VERTEX].buffer = saved[ATT_VERTEX].buffer;
-    }
-    if(list->color) {
-        glstate->vao->vertexattrib[ATT_COLOR].real_buffer = saved[ATT_COLOR].real_buffer;
-        glstate->vao->vertexattrib[ATT_COLOR].real_pointer = saved[ATT_COLOR].real_pointer;
-        glstate->vao->vertexattrib[ATT_COLOR].buffer = saved[ATT_COLOR].buffer;
-    }
-    if(list->secondary) {
-        glstate->vao->vertexattrib[ATT_SECONDARY].real_buffer = saved[ATT_SECONDARY].real_buffer;
-        glstate->vao->vertexattrib[ATT_SECONDARY].real_pointer = saved[ATT_SECONDARY].real_pointer;
-        glstate->vao->vertexattrib[ATT_SECONDARY].buffer = saved[ATT_SECONDARY].buffer;
-    }
-    if(list->fogcoord) {
-        glstate->vao->vertexattrib[ATT_FOGCOORD].real_buffer = saved[ATT_FOGCOORD].real_buffer;
-        glstate->vao->vertexattrib[ATT_FOGCOORD].real_pointer = saved[ATT_FOGCOORD].real_pointer;
-        glstate->vao->vertexattrib[ATT_FOGCOORD].buffer = saved[ATT_FOGCOORD].buffer;
-    }
-    if(list->normal) {
-        glstate->vao->vertexattrib[ATT_NORMAL].real_buffer = saved[ATT_NORMAL].real_buffer;
-        glstate->vao->vertexattrib[ATT_NORMAL].real_pointer = saved[ATT_NORMAL].real_pointer;
-        glstate->vao->vertexattrib[ATT_NORMAL].buffer = saved[ATT_NORMAL].buffer;
-    }
-    for (int a=0; a<list->maxtex; ++a) {
-        if(list->tex[a]) {
-            glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].real_buffer = saved[ATT_MULTITEXCOORD0+a].real_buffer;
-            glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].real_pointer = saved[ATT_MULTITEXCOORD0+a].real_pointer;
-            glstate->vao->vertexattrib[ATT_MULTITEXCOORD0+a].buffer = saved[ATT_MULTITEXCOORD0+a].buffer;
-        }
-    }
+    if(list->vert)
+        inactiveVBO(ATT_VERTEX, saved);
+    if(list->color)
+        inactiveVBO(ATT_COLOR, saved);
+    if(list->secondary)
+        inactiveVBO(ATT_SECONDARY, saved);
+    if(list->fogcoord)
+        inactiveVBO(ATT_FOGCOORD, saved);
+    if(list->normal)
+        inactiveVBO(ATT_NORMAL, saved);
+    for (int a=0; a<list->maxtex; ++a)
+        if(list->tex[a])
+            inactiveVBO(ATT_MULTITEXCOORD0+a, saved);
 }
 
 int fill_lineIndices(modeinit_t *modes, int length, GLenum mode, GLushort* indices, GLushort *ind_line)
@@ -402,11 +553,8 @@ void draw_renderlist(renderlist_t *list) {
         if (list->popattribute)
             gl4es_glPopAttrib();
         call_list_t *cl = &list->calls;
-        if (cl->len > 0) {
-            for (int i = 0; i < cl->len; i++) {
-                glPackedCall(cl->calls[i]);
-            }
-        }
+        for (char *call = cl->data, *end = cl->data+cl->size; call<end; call += CALLHEAD(call)->size)
+            glPackedCall(CALLPACKED(call));
         if(list->render_op) {
             switch(list->render_op) {
                 case 1: gl4es_glInitNames(); break;
@@ -711,9 +859,12 @@ void draw_renderlist(renderlist_t *list) {
         if(use_vbo_array==0) {
             if((glstate->render_mode == GL_SELECT) || (glstate->polygon_mode == GL_LINE) || (glstate->polygon_mode == GL_POINT))
                 use_vbo_array = 1;
-            else
+            else {
                 // evaluated, seems good to go !
+                TRACE_BEGIN(trace_t0);
                 use_vbo_array = list2VBO(list);
+                TRACE_END(trace_t0, "list2VBO", list->len);
+            }
         }
         save_vbo_t saved[NB_VA];
         if(use_vbo_array==2)
@@ -755,11 +906,16 @@ void draw_renderlist(renderlist_t *list) {
                     int vbo_indices = 0;
                     if(!use_vbo_indices) {
                         // create VBO for indices
-                        LOAD_GLES2(glGenBuffers);
-                        LOAD_GLES2(glBufferData);
-                        gles_glGenBuffers(1, &list->vbo_indices);
-                        bindBuffer(GL_ELEMENT_ARRAY_BUFFER, list->vbo_indices);
-                        gles_glBufferData(GL_ELEMENT_ARRAY_BUFFER, list->ilen*sizeof(GLushort), indices, GL_STATIC_DRAW);
+                        const GLuint size = list->ilen*sizeof(GLushort);
+                        if(listvbo_alloc(LISTVBO_INDICES, size, indices, &list->listvbo, &list->vbo_indices, &list->vbo_indices_offset))
+                            list->vbo_indices_size = size;
+                        else {
+                            LOAD_GLES2(glGenBuffers);
+                            LOAD_GLES2(glBufferData);
+                            gles_glGenBuffers(1, &list->vbo_indices);
+                            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, list->vbo_indices);
+                            gles_glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
+                        }
                         use_vbo_indices = 2;
                         vbo_indices = 1;
                     } else if(use_vbo_indices==2) {
@@ -768,10 +924,12 @@ void draw_renderlist(renderlist_t *list) {
                     } else
                         realize_bufferIndex();
                     if(list->instanceCount==1)
-                        gles_glDrawElements(mode, list->ilen, GL_UNSIGNED_SHORT, vbo_indices?NULL:indices);
+                        gles_glDrawElements(mode, list->ilen, GL_UNSIGNED_SHORT, vbo_indices?(GLvoid*)(uintptr_t)list->vbo_indices_offset:indices);
+                    else if(hardext.esversion>1)
+                        fpe_glDrawElementsInstanced(mode, list->ilen, GL_UNSIGNED_SHORT, vbo_indices?(GLvoid*)(uintptr_t)list->vbo_indices_offset:indices, list->instanceCount);
                     else {
                         for (glstate->instanceID=0; glstate->instanceID<list->instanceCount; ++glstate->instanceID)
-                            gles_glDrawElements(mode, list->ilen, GL_UNSIGNED_SHORT, vbo_indices?NULL:indices);
+                            gles_glDrawElements(mode, list->ilen, GL_UNSIGNED_SHORT, vbo_indices?(GLvoid*)(uintptr_t)list->vbo_indices_offset:indices);
                         glstate->instanceID = 0;
                     }
                 }
@@ -800,6 +958,8 @@ void draw_renderlist(renderlist_t *list) {
                 } else {
                     if(list->instanceCount==1)
                         gles_glDrawArrays(mode, 0, len);
+                    else if(hardext.esversion>1)
+                        fpe_glDrawArraysInstanced(mode, 0, len, list->instanceCount);
                     else {
                         for (glstate->instanceID=0; glstate->instanceID<list->instanceCount; ++glstate->instanceID)
                             gles_glDrawArrays(mode, 0, len);
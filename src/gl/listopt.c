@@ -0,0 +1,334 @@
+#include "listopt.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "gl4es.h"
+#include "init.h"
+#include "wrap/gles.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+#define LISTOPT_CAPS    32      // glEnable / glDisable caps tracked at the same time
+#define LISTOPT_ARGS    16      // largest arguments of a tracked setter
+
+// state setters tracked by the optimizer
+typedef struct {
+    void*   func;
+    int     group;      // setters of the same (non 0) group change the same state
+    size_t  offset;     // of the arguments in the packed call
+    size_t  size;       // of the arguments
+} listopt_setter_t;
+
+#define SETTER(A, G) {(void*)gl4es_##A, G, offsetof(A##_PACKED, args), sizeof(((A##_PACKED*)0)->args)}
+static const listopt_setter_t setters[] = {
+    SETTER(glShadeModel, 0),
+    SETTER(glAlphaFunc, 0),
+    SETTER(glLogicOp, 0),
+    SETTER(glColorMask, 0),
+    SETTER(glBlendFunc, 1),
+    SETTER(glBlendFuncSeparate, 1),
+    SETTER(glBlendEquation, 2),
+    SETTER(glBlendEquationSeparate, 2),
+    SETTER(glBlendColor, 0),
+    SETTER(glDepthFunc, 0),
+    SETTER(glDepthMask, 0),
+    SETTER(glDepthRangef, 0),
+    SETTER(glClearDepthf, 0),
+    SETTER(glCullFace, 0),
+    SETTER(glFrontFace, 0),
+    SETTER(glStencilFunc, 0),
+    SETTER(glStencilOp, 0),
+    SETTER(glStencilMask, 0),
+    SETTER(glClearStencil, 0),
+    SETTER(glMatrixMode, 0),
+};
+#undef SETTER
+#define LISTOPT_SETTERS (sizeof(setters)/sizeof(setters[0]))
+#define SETTER_MATRIXMODE   (LISTOPT_SETTERS-1)
+#define SETTER_ENABLE       LISTOPT_SETTERS     // glEnable / glDisable, the "value" is the cap
+
+typedef struct {
+    GLenum  cap;
+    int     on;
+} listopt_cap_t;
+
+// state known to be in effect while walking the list (everything is unknown at start)
+typedef struct {
+    int             valid[LISTOPT_SETTERS];
+    unsigned char   value[LISTOPT_SETTERS][LISTOPT_ARGS];
+    listopt_cap_t   caps[LISTOPT_CAPS];
+    int             ncaps;
+    int             tmu;        // active texture (-1 is the one in effect when the list is called)
+    int             tmu_known;
+    int             bind_valid; // last texture bound
+    int             bind_tmu;
+    GLenum          bind_target;
+    GLuint          bind_texture;
+    int             load_valid; // last matrix loaded, with the matrix mode unchanged since
+    GLfloat         load[16];
+} listopt_state_t;
+
+typedef struct {
+    int lists;
+    int calls;
+    int binds;
+    int matrix;
+} listopt_stats_t;
+
+static void forget_all(listopt_state_t *s) {
+    memset(s->valid, 0, sizeof(s->valid));
+    s->ncaps = 0;
+    s->tmu = -1;
+    s->tmu_known = 0;
+    s->bind_valid = 0;
+    s->load_valid = 0;
+}
+
+static int is_texture_cap(GLenum cap) {
+    switch(cap) {
+        case GL_TEXTURE_1D:
+        case GL_TEXTURE_2D:
+        case GL_TEXTURE_3D:
+        case GL_TEXTURE_CUBE_MAP:
+        case GL_TEXTURE_RECTANGLE_ARB:
+        case GL_TEXTURE_GEN_S:
+        case GL_TEXTURE_GEN_T:
+        case GL_TEXTURE_GEN_R:
+        case GL_TEXTURE_GEN_Q:
+            return 1;
+    }
+    return 0;
+}
+
+// the per texture unit caps are unknown after a change of active texture
+static void forget_texture_caps(listopt_state_t *s) {
+    int j = 0;
+    for (int i=0; i<s->ncaps; i++)
+        if(!is_texture_cap(s->caps[i].cap))
+            s->caps[j++] = s->caps[i];
+    s->ncaps = j;
+}
+
+// setter index of a packed call, -1 if it's not a tracked setter
+static int find_setter(packed_call_t *p) {
+    if(p->func==(void*)gl4es_glEnable || p->func==(void*)gl4es_glDisable)
+        return SETTER_ENABLE;
+    for (int i=0; i<LISTOPT_SETTERS; i++)
+        if(p->func==setters[i].func)
+            return i;
+    return -1;
+}
+
+// drop the overwritten and redundant setters of the calls of a list, update the known state
+static void optimize_calls(renderlist_t *list, listopt_state_t *s) {
+    call_list_t *cl = &list->calls;
+    if(!cl->len)
+        return;
+    // last call of each setter since the last barrier (offset in the calls, -1 if none)
+    long pending[LISTOPT_SETTERS];
+    for (int i=0; i<LISTOPT_SETTERS; i++)
+        pending[i] = -1;
+    struct {GLenum cap; long call;} pending_caps[LISTOPT_CAPS];
+    int npending_caps = 0;
+    char *drop = (char*)calloc(cl->len, 1);
+    long *offsets = (long*)malloc(cl->len*sizeof(long));
+    int n = 0, ndrop = 0;
+    for (char *call = cl->data, *end = cl->data+cl->size; call<end; call += CALLHEAD(call)->size, ++n) {
+        offsets[n] = call - cl->data;
+        packed_call_t *p = (packed_call_t*)CALLPACKED(call);
+        int k = find_setter(p);
+        if(k<0) {
+            // barrier: anything can be read or changed
+            forget_all(s);
+            for (int i=0; i<LISTOPT_SETTERS; i++)
+                pending[i] = -1;
+            npending_caps = 0;
+            continue;
+        }
+        if(k==SETTER_ENABLE) {
+            const GLenum cap = ((glEnable_PACKED*)p)->args.a1;
+            const int on = (p->func==(void*)gl4es_glEnable)?1:0;
+            int i;
+            for (i=0; i<s->ncaps && s->caps[i].cap!=cap; i++);
+            if(i<s->ncaps && s->caps[i].on==on) {
+                drop[n] = 1; ++ndrop;
+                continue;
+            }
+            if(i<s->ncaps)
+                s->caps[i].on = on;
+            else if(s->ncaps<LISTOPT_CAPS) {
+                s->caps[s->ncaps].cap = cap;
+                s->caps[s->ncaps++].on = on;
+            }
+            for (i=0; i<npending_caps && pending_caps[i].cap!=cap; i++);
+            if(i<npending_caps) {
+                drop[pending_caps[i].call] = 1; ++ndrop;
+                pending_caps[i].call = n;
+            } else if(npending_caps<LISTOPT_CAPS) {
+                pending_caps[npending_caps].cap = cap;
+                pending_caps[npending_caps++].call = n;
+            }
+            continue;
+        }
+        const unsigned char *args = (const unsigned char*)p + setters[k].offset;
+        if(s->valid[k] && !memcmp(s->value[k], args, setters[k].size)) {
+            drop[n] = 1; ++ndrop;
+            continue;
+        }
+        if(pending[k]>=0) {
+            drop[pending[k]] = 1; ++ndrop;
+        }
+        pending[k] = n;
+        if(setters[k].group)
+            for (int i=0; i<LISTOPT_SETTERS; i++)
+                if(setters[i].group==setters[k].group)
+                    s->valid[i] = 0;
+        s->valid[k] = 1;
+        memcpy(s->value[k], args, setters[k].size);
+        if(k==SETTER_MATRIXMODE)
+            s->load_valid = 0;
+    }
+    if(ndrop==n) {
+        // no call left
+        if(list->shared_calls && (*list->shared_calls)>0)
+            --(*list->shared_calls);
+        else {
+            if(list->shared_calls) free(list->shared_calls);
+            listpool_free(cl->data, cl->cap);
+        }
+        list->shared_calls = NULL;
+        memset(cl, 0, sizeof(call_list_t));
+    } else if(ndrop) {
+        if(list->shared_calls && (*list->shared_calls)>0) {
+            // the calls are shared with another list, take a copy before changing them
+            --(*list->shared_calls);
+            list->shared_calls = NULL;
+            char *data = (char*)listpool_alloc(cl->cap);
+            memcpy(data, cl->data, cl->size);
+            cl->data = data;
+        }
+        unsigned long size = 0;
+        for (int i=0; i<n; i++) {
+            if(drop[i])
+                continue;
+            char *call = cl->data+offsets[i];
+            unsigned long len = CALLHEAD(call)->size;
+            if(size!=offsets[i])
+                memmove(cl->data+size, call, len);
+            size += len;
+        }
+        cl->size = size;
+        cl->len -= ndrop;
+    }
+    free(offsets);
+    free(drop);
+}
+
+// drop the glActiveTexture, texture bind and matrix load of a list if they are already in effect
+static void optimize_ops(renderlist_t *list, listopt_state_t *s) {
+    // matrix (after the calls, that can change the matrix mode)
+    if(list->matrix_op==1) {
+        if(s->load_valid && !memcmp(s->load, list->matrix_val, 16*sizeof(GLfloat)))
+            list->matrix_op = 0;
+        else {
+            s->load_valid = 1;
+            memcpy(s->load, list->matrix_val, 16*sizeof(GLfloat));
+        }
+    } else if(list->matrix_op)
+        s->load_valid = 0;
+    // active texture
+    if(list->set_tmu) {
+        if(s->tmu_known && s->tmu==list->tmu)
+            list->set_tmu = false;
+        else {
+            s->tmu = list->tmu;
+            s->tmu_known = 1;
+            forget_texture_caps(s);
+            s->load_valid = 0;      // could be a texture matrix
+        }
+    }
+    // texture bind
+    if(list->set_texture) {
+        if(s->bind_valid && s->bind_tmu==s->tmu && s->bind_target==list->target_texture && s->bind_texture==list->texture)
+            list->set_texture = false;
+        else {
+            s->bind_valid = 1;
+            s->bind_tmu = s->tmu;
+            s->bind_target = list->target_texture;
+            s->bind_texture = list->texture;
+        }
+    }
+}
+
+// a renderlist that does nothing at all
+static int isnop_renderlist(renderlist_t *list) {
+    return !list->len && !list->calls.len && !list->matrix_op && !list->raster_op && !list->raster && !list->bitmaps
+        && !list->pushattribute && !list->popattribute && !list->render_op && !list->fog_op && !list->pointparam_op
+        && !list->linestipple_op && !list->material && !list->colormat_face && !list->light && !list->lightmodel
+        && !list->texgen && !list->texenv && !list->polygon_mode && !list->set_texture && !list->set_tmu
+        && !list->post_color && !list->post_normal;
+}
+
+// unlink a renderlist from its chain and free it
+static void remove_renderlist(renderlist_t *list) {
+    if(list->prev) list->prev->next = list->next;
+    if(list->next) list->next->prev = list->prev;
+    list->prev = list->next = NULL;
+    free_renderlist(list);
+}
+
+static void get_stats(renderlist_t *list, listopt_stats_t *stats) {
+    memset(stats, 0, sizeof(listopt_stats_t));
+    for (; list; list = list->next) {
+        ++stats->lists;
+        stats->calls += list->calls.len;
+        stats->binds += (list->set_texture?1:0) + (list->set_tmu?1:0);
+        stats->matrix += (list->matrix_op?1:0);
+    }
+}
+
+renderlist_t* listopt_optimize(renderlist_t* first) {
+    if(!first)
+        return first;
+    listopt_stats_t before;
+    if(globals4es.listopt>1)
+        get_stats(first, &before);
+    // drop what is overwritten or already in effect, in execution order
+    listopt_state_t state;
+    forget_all(&state);
+    for (renderlist_t *list = first; list; list = list->next) {
+        if(list->popattribute)
+            forget_all(&state);
+        optimize_calls(list, &state);
+        optimize_ops(list, &state);
+    }
+    // remove the empty renderlists, and merge the draws that are now adjacent
+    while(first->next && isnop_renderlist(first)) {
+        renderlist_t *list = first;
+        first = first->next;
+        remove_renderlist(list);
+    }
+    for (renderlist_t *list = first; list->next; ) {
+        renderlist_t *next = list->next;
+        if(isnop_renderlist(next))
+            remove_renderlist(next);
+        else if(ispurerender_renderlist(next) && islistscompatible_renderlist(list, next)) {
+            append_renderlist(list, next);
+            remove_renderlist(next);
+        } else
+            list = next;
+    }
+    if(globals4es.listopt>1) {
+        listopt_stats_t after;
+        get_stats(first, &after);
+        SHUT_LOGD("List %u optimized: renderlists %d => %d, calls %d => %d, binds %d => %d, matrix ops %d => %d\n", first->name,
+            before.lists, after.lists, before.calls, after.calls, before.binds, after.binds, before.matrix, after.matrix);
+    }
+    return first;
+}
@@ -0,0 +1,17 @@
+#ifndef _GL4ES_LISTOPT_H_
+#define _GL4ES_LISTOPT_H_
+
+#include "list.h"
+
+// Optimizer pass of display lists, run by glEndList (see LIBGL_LISTOPT)
+// Walking the chain of renderlists in execution order, it
+//  - drops the state calls overwritten before anything uses them, and the ones that set a value already in effect
+//  - drops the texture binds, glActiveTexture and matrix loads already in effect
+//  - merges the draws of adjacent renderlists left with no state change in between, and removes the empty renderlists
+// Only known state setters (glEnable/glDisable, blend, depth, stencil, face, glMatrixMode...) are tracked,
+// any other call is a barrier that forgets everything, like glPopAttrib.
+
+// optimize the compiled list starting at "first" (all renderlists still open), return the new first renderlist
+renderlist_t* listopt_optimize(renderlist_t* first);
+
+#endif // _GL4ES_LISTOPT_H_
@@ -0,0 +1,104 @@
+#include "listpool.h"
+
+#include <stdlib.h>
+
+#include "counters.h"
+#include "gl4es.h"
+#include "glstate.h"
+#include "init.h"
+#include "list.h"
+
+// class of the blocks for "size" bytes (-1 if too big to be pooled)
+static int listpool_class(size_t size) {
+    int c = 0;
+    while(c<LISTPOOL_CLASSES && (LISTPOOL_MINBLOCK<<c)<size)
+        ++c;
+    return (c<LISTPOOL_CLASSES)?c:-1;
+}
+
+static listpool_t* listpool_get() {
+    if(!globals4es.listpool || !glstate)
+        return NULL;
+    if(!glstate->listpool)
+        glstate->listpool = (listpool_t*)calloc(1, sizeof(listpool_t));
+    return glstate->listpool;
+}
+
+size_t listpool_blocksize(size_t size) {
+    int c = listpool_class(size);
+    return (c<0)?size:((size_t)LISTPOOL_MINBLOCK<<c);
+}
+
+void* listpool_alloc(size_t size) {
+    int c = listpool_class(size);
+    listpool_t *pool = listpool_get();
+    if(pool && c>=0 && pool->nblocks[c]) {
+        COUNTER_INC(list_recycled);
+        return pool->blocks[c][--pool->nblocks[c]];
+    }
+    COUNTER_INC(list_allocs);
+    // blocks are always allocated with their class size (even without pool), so they can be given back to it later
+    return malloc((c<0)?size:((size_t)LISTPOOL_MINBLOCK<<c));
+}
+
+void* listpool_realloc(void* p, size_t size) {
+    if(!p)
+        return listpool_alloc(size);
+    COUNTER_INC(list_allocs);
+    return realloc(p, listpool_blocksize(size));
+}
+
+void listpool_free(void* p, size_t size) {
+    if(!p)
+        return;
+    listpool_t *pool = listpool_get();
+    if(pool && size>=LISTPOOL_MINBLOCK) {
+        // largest class that fits in the block
+        int c = 0;
+        while(c<LISTPOOL_CLASSES && ((size_t)LISTPOOL_MINBLOCK<<(c+1))<=size)
+            ++c;
+        if(c<LISTPOOL_CLASSES && pool->nblocks[c]<LISTPOOL_DEPTH) {
+            pool->blocks[c][pool->nblocks[c]++] = p;
+            return;
+        }
+    }
+    free(p);
+}
+
+renderlist_t* listpool_getlist() {
+    listpool_t *pool = listpool_get();
+    if(pool && pool->lists) {
+        renderlist_t *list = pool->lists;
+        pool->lists = list->next;
+        --pool->nlists;
+        COUNTER_INC(list_recycled);
+        return list;
+    }
+    COUNTER_INC(list_allocs);
+    return (renderlist_t*)malloc(sizeof(renderlist_t));
+}
+
+void listpool_putlist(renderlist_t* list) {
+    listpool_t *pool = listpool_get();
+    if(pool && pool->nlists<LISTPOOL_LISTS) {
+        list->next = pool->lists;
+        pool->lists = list;
+        ++pool->nlists;
+        return;
+    }
+    free(list);
+}
+
+void listpool_destroy(listpool_t* pool) {
+    if(!pool)
+        return;
+    while(pool->lists) {
+        renderlist_t *list = pool->lists;
+        pool->lists = list->next;
+        free(list);
+    }
+    for (int c=0; c<LISTPOOL_CLASSES; ++c)
+        for (int i=0; i<pool->nblocks[c]; ++i)
+            free(pool->blocks[c][i]);
+    free(pool);
+}
@@ -0,0 +1,42 @@
+#ifndef _GL4ES_LISTPOOL_H_
+#define _GL4ES_LISTPOOL_H_
+
+#include <stddef.h>
+
+// Recycling of renderlists and of their arrays (see LIBGL_LISTPOOL)
+// Freed renderlist_t and the blocks of their arrays (vertices, indices, mode_inits) are kept in
+// a per context pool, the blocks sorted in power of 2 size classes. alloc_renderlist and the
+// renderlist arrays take from the pool first, so immediate mode frames in steady state don't
+// allocate anymore. Pooled blocks are plain malloc blocks: they can still be realloc / free normally.
+
+#define LISTPOOL_MINBLOCK   256         // smallest class, in bytes
+#define LISTPOOL_CLASSES    11          // largest class is LISTPOOL_MINBLOCK<<(LISTPOOL_CLASSES-1) (256KB)
+#define LISTPOOL_DEPTH      8           // blocks kept per class
+#define LISTPOOL_LISTS      64          // renderlist_t kept
+
+struct _renderlist_t;
+
+struct listpool_s {
+    struct _renderlist_t* lists;      // free renderlist_t, chained by next
+    int             nlists;
+    void*           blocks[LISTPOOL_CLASSES][LISTPOOL_DEPTH];
+    int             nblocks[LISTPOOL_CLASSES];
+};
+typedef struct listpool_s listpool_t;
+
+// size actually allocated by listpool_alloc / listpool_realloc for "size" bytes
+size_t listpool_blocksize(size_t size);
+// a block of at least listpool_blocksize(size) bytes
+void* listpool_alloc(size_t size);
+// realloc p to at least listpool_blocksize(size) bytes
+void* listpool_realloc(void* p, size_t size);
+// give back a block of at least "size" bytes (it's freed if the pool is full)
+void listpool_free(void* p, size_t size);
+// a renderlist_t (not initialized)
+struct _renderlist_t* listpool_getlist();
+// give back a renderlist_t (its arrays have already been freed)
+void listpool_putlist(struct _renderlist_t* list);
+// free the pool of a glstate
+void listpool_destroy(listpool_t* pool);
+
+#endif // _GL4ES_LISTPOOL_H_
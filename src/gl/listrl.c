@@ -461,16 +461,29 @@ void rlPointParamOp(renderlist_t *list, int op, const GLfloat* v) {
     list->pointparam_val[3] = v[3];
 }
 
-void rlPushCall(renderlist_t *list, packed_call_t *data) {
+void* rlPushCall(renderlist_t *list, int size) {
     call_list_t *cl = &list->calls;
-    if (!cl->calls) {
-        cl->cap = DEFAULT_CALL_LIST_CAPACITY;
-        cl->calls = malloc(DEFAULT_CALL_LIST_CAPACITY * sizeof(void*));
-    } else if (list->calls.len == list->calls.cap) {
-        cl->cap += DEFAULT_CALL_LIST_CAPACITY;
-        cl->calls = realloc(cl->calls, cl->cap * sizeof(void*));
+    if (list->shared_calls && (*list->shared_calls)>0) {
+        // the calls are shared with another list (glCallList while compiling), take a copy before adding to them
+        --(*list->shared_calls);
+        list->shared_calls = NULL;
+        char *data = (char*)listpool_alloc(cl->cap);
+        memcpy(data, cl->data, cl->size);
+        cl->data = data;
     }
-    cl->calls[cl->len++] = data;
+    size = (sizeof(callhead_t)+size+7)&~7;
+    if (cl->size+size > cl->cap) {
+        unsigned long cap = (cl->cap)?(cl->cap*2):DEFAULT_CALL_LIST_CAPACITY;
+        while (cap < cl->size+size)
+            cap *= 2;
+        cl->data = (char*)listpool_realloc(cl->data, cap);
+        cl->cap = listpool_blocksize(cap);
+    }
+    char *call = cl->data + cl->size;
+    CALLHEAD(call)->size = size;
+    cl->size += size;
+    cl->len++;
+    return CALLPACKED(call);
 }
 
 renderlist_t* GetFirst(renderlist_t* list) {
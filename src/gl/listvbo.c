@@ -0,0 +1,154 @@
+#include "listvbo.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "buffers.h"
+#include "counters.h"
+#include "gl4es.h"
+#include "glstate.h"
+#include "init.h"
+#include "loader.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+static const GLenum listvbo_target[LISTVBO_TARGETS] = {GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER};
+
+// insert a free range at position "i" of a block
+static void insert_range(listvbo_block_t *b, int i, GLuint offset, GLuint size) {
+    if(b->nfree==b->capfree) {
+        b->capfree = (b->capfree)?(b->capfree*2):16;
+        b->free = (listvbo_range_t*)realloc(b->free, b->capfree*sizeof(listvbo_range_t));
+    }
+    memmove(b->free+i+1, b->free+i, (b->nfree-i)*sizeof(listvbo_range_t));
+    b->free[i].offset = offset;
+    b->free[i].size = size;
+    ++b->nfree;
+}
+
+static void remove_range(listvbo_block_t *b, int i) {
+    memmove(b->free+i, b->free+i+1, (b->nfree-i-1)*sizeof(listvbo_range_t));
+    --b->nfree;
+}
+
+// first fit in a block, return the offset or -1
+static long alloc_range(listvbo_block_t *b, GLuint size) {
+    for (int i=0; i<b->nfree; ++i) {
+        listvbo_range_t *r = b->free+i;
+        if(r->size<size)
+            continue;
+        GLuint offset = r->offset;
+        r->offset += size;
+        r->size -= size;
+        if(!r->size)
+            remove_range(b, i);
+        b->used += size;
+        return offset;
+    }
+    return -1;
+}
+
+// add a new (empty) block to a pool
+static listvbo_block_t* new_block(listvbo_t *pool, int which) {
+    LOAD_GLES2(glGenBuffers);
+    LOAD_GLES2(glBufferData);
+    if(!gles_glGenBuffers || !gles_glBufferData)
+        return NULL;
+    pool->blocks[which] = (listvbo_block_t*)realloc(pool->blocks[which], (pool->nblocks[which]+1)*sizeof(listvbo_block_t));
+    listvbo_block_t *b = pool->blocks[which]+pool->nblocks[which];
+    memset(b, 0, sizeof(listvbo_block_t));
+    gles_glGenBuffers(1, &b->buffer);
+    bindBuffer(listvbo_target[which], b->buffer);
+    gles_glBufferData(listvbo_target[which], LISTVBO_BLOCK, NULL, GL_STATIC_DRAW);
+    insert_range(b, 0, 0, LISTVBO_BLOCK);
+    ++pool->nblocks[which];
+    COUNTER_INC(listvbo_blocks);
+    DBG(SHUT_LOGD("listvbo: new %s block %u (%d blocks)\n", which?"indices":"arrays", b->buffer, pool->nblocks[which]);)
+    return b;
+}
+
+int listvbo_alloc(int which, GLuint size, const void* data, listvbo_t** pool_out, GLuint* buffer, GLuint* offset) {
+    if(!globals4es.listvbo || !glstate || !glstate->listvbo || !size || size>LISTVBO_MAXSIZE)
+        return 0;
+    LOAD_GLES2(glBufferSubData);
+    if(!gles_glBufferSubData)
+        return 0;
+    listvbo_t *pool = glstate->listvbo;
+    const GLuint len = size;
+    size = (size+LISTVBO_ALIGN-1)&~(LISTVBO_ALIGN-1);
+    // newest blocks first, they are the less fragmented
+    listvbo_block_t *b = NULL;
+    long off = -1;
+    for (int i=pool->nblocks[which]-1; i>=0 && off<0; --i) {
+        b = pool->blocks[which]+i;
+        off = alloc_range(b, size);
+    }
+    if(off<0) {
+        b = new_block(pool, which);
+        if(!b)
+            return 0;
+        off = alloc_range(b, size);
+    }
+    bindBuffer(listvbo_target[which], b->buffer);
+    gles_glBufferSubData(listvbo_target[which], off, len, data);
+    *pool_out = pool;
+    *buffer = b->buffer;
+    *offset = off;
+    COUNTER_INC(listvbo_allocs);
+    return 1;
+}
+
+void listvbo_free(listvbo_t* pool, int which, GLuint buffer, GLuint offset, GLuint size) {
+    // buffer names are per context, so the range goes back to the pool it comes from, whatever the current glstate
+    if(!pool || pool->closing)
+        return;
+    size = (size+LISTVBO_ALIGN-1)&~(LISTVBO_ALIGN-1);
+    int n;
+    for (n=0; n<pool->nblocks[which] && pool->blocks[which][n].buffer!=buffer; ++n);
+    if(n==pool->nblocks[which])
+        return;
+    listvbo_block_t *b = pool->blocks[which]+n;
+    // sorted insertion, merged with the free neighbours
+    int i;
+    for (i=0; i<b->nfree && b->free[i].offset<offset; ++i);
+    const int prev = (i>0 && b->free[i-1].offset+b->free[i-1].size==offset);
+    const int next = (i<b->nfree && offset+size==b->free[i].offset);
+    if(prev && next) {
+        b->free[i-1].size += size + b->free[i].size;
+        remove_range(b, i);
+    } else if(prev)
+        b->free[i-1].size += size;
+    else if(next) {
+        b->free[i].offset = offset;
+        b->free[i].size += size;
+    } else
+        insert_range(b, i, offset, size);
+    b->used -= size;
+    // an empty block is deleted, unless it's the last one
+    if(!b->used && pool->nblocks[which]>1) {
+        deleteSingleBuffer(b->buffer);
+        free(b->free);
+        memmove(b, b+1, (pool->nblocks[which]-n-1)*sizeof(listvbo_block_t));
+        --pool->nblocks[which];
+    }
+}
+
+void listvbo_destroy(listvbo_t* pool) {
+    if(!pool)
+        return;
+    LOAD_GLES2(glDeleteBuffers);
+    for (int w=0; w<LISTVBO_TARGETS; ++w) {
+        for (int i=0; i<pool->nblocks[w]; ++i) {
+            if(gles_glDeleteBuffers)
+                gles_glDeleteBuffers(1, &pool->blocks[w][i].buffer);
+            free(pool->blocks[w][i].free);
+        }
+        free(pool->blocks[w]);
+    }
+    free(pool);
+}
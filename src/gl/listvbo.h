@@ -0,0 +1,49 @@
+#ifndef _GL4ES_LISTVBO_H_
+#define _GL4ES_LISTVBO_H_
+
+#include "gles.h"
+
+// Pooled GPU storage of display lists geometry (see LIBGL_LISTVBO)
+// Instead of 1 VBO per renderlist (and 1 more for its indices), the arrays and indices of the lists are
+// sub-allocated in a few large VBOs, with a first fit free list per VBO. Consecutive glCallList then mostly
+// draw from the same buffers, without a bind in between. Data too large for a block still get their own VBO.
+
+#define LISTVBO_BLOCK       (4*1024*1024)       // size of a pooled VBO, in bytes
+#define LISTVBO_MAXSIZE     (LISTVBO_BLOCK/4)   // larger data get their own VBO
+#define LISTVBO_ALIGN       16                  // alignment of the ranges
+
+enum {
+    LISTVBO_ARRAYS = 0,     // GL_ARRAY_BUFFER
+    LISTVBO_INDICES,        // GL_ELEMENT_ARRAY_BUFFER
+    LISTVBO_TARGETS
+};
+
+typedef struct {
+    GLuint  offset;
+    GLuint  size;
+} listvbo_range_t;
+
+typedef struct {
+    GLuint          buffer;
+    GLuint          used;       // bytes allocated in the block
+    listvbo_range_t *free;      // free ranges, sorted by offset
+    int             nfree;
+    int             capfree;
+} listvbo_block_t;
+
+struct listvbo_s {
+    listvbo_block_t *blocks[LISTVBO_TARGETS];
+    int             nblocks[LISTVBO_TARGETS];
+    int             closing;    // the pool is about to be destroyed with its glstate, ranges are not given back anymore
+};
+typedef struct listvbo_s listvbo_t;
+
+// upload "size" bytes of data in a pooled VBO of "which" (LISTVBO_ARRAYS / LISTVBO_INDICES) of the current glstate
+// return 1 and the pool / buffer / offset of the data, or 0 if it cannot be pooled (the caller then uses its own VBO)
+int listvbo_alloc(int which, GLuint size, const void* data, listvbo_t** pool, GLuint* buffer, GLuint* offset);
+// give back a range allocated by listvbo_alloc to its pool
+void listvbo_free(listvbo_t* pool, int which, GLuint buffer, GLuint offset, GLuint size);
+// delete the pooled VBO of a glstate
+void listvbo_destroy(listvbo_t* pool);
+
+#endif // _GL4ES_LISTVBO_H_
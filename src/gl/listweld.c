@@ -0,0 +1,264 @@
+#include "listweld.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "const.h"
+#include "counters.h"
+#include "init.h"
+#include "logs.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+// one vertex attribute of a renderlist
+typedef struct {
+    GLfloat *data;
+    int     n;          // components
+    int     stride;     // in GLfloat
+} listweld_attrib_t;
+
+static int get_attribs(renderlist_t *list, listweld_attrib_t *attribs) {
+    int n = 0;
+    #define GO(A, N, S) if(list->A) { attribs[n].data = list->A; attribs[n].n = N; attribs[n].stride = (S)?(S)/sizeof(GLfloat):(N); ++n; }
+    GO(vert, 4, list->vert_stride);
+    GO(normal, 3, list->normal_stride);
+    GO(color, 4, list->color_stride);
+    GO(secondary, 4, list->secondary_stride);
+    GO(fogcoord, 1, list->fogcoord_stride);
+    for (int a=0; a<list->maxtex; a++)
+        GO(tex[a], 4, list->tex_stride[a]);
+    #undef GO
+    return n;
+}
+
+// FNV-1a of all the attributes of a vertex
+static uint32_t hash_vertex(const listweld_attrib_t *attribs, int nattribs, int i) {
+    uint32_t h = 2166136261u;
+    for (int a=0; a<nattribs; a++) {
+        const unsigned char *p = (const unsigned char*)(attribs[a].data+i*attribs[a].stride);
+        for (int j=0; j<attribs[a].n*(int)sizeof(GLfloat); j++)
+            h = (h^p[j])*16777619u;
+    }
+    return h;
+}
+
+// bit exact comparison (a -0.0 or NaN payload stays a different vertex)
+static int same_vertex(const listweld_attrib_t *attribs, int nattribs, int i, int j) {
+    for (int a=0; a<nattribs; a++)
+        if(memcmp(attribs[a].data+i*attribs[a].stride, attribs[a].data+j*attribs[a].stride, attribs[a].n*sizeof(GLfloat)))
+            return 0;
+    return 1;
+}
+
+// Forsyth's vertex score
+static float vertex_score(int pos, int valence) {
+    if(!valence)
+        return -1.0f;
+    float score = 0.0f;
+    if(pos>=0)
+        score = (pos<3)?0.75f:powf(1.0f-(float)(pos-3)/(LISTWELD_CACHE-3), 1.5f);
+    return score + 2.0f/sqrtf((float)valence);
+}
+
+// reorder the units (1 triangle, or the 2 triangles of a quad) of an indexed GL_TRIANGLES list for the vertex cache
+static void reorder_triangles(GLushort *indices, int ilen, int nverts, int k) {
+    const int usize = 3*k;
+    const int nunits = ilen/usize;
+    if(nunits<3 || nunits*usize!=ilen)
+        return;
+    int *valence = (int*)calloc(nverts, sizeof(int));
+    int *start = (int*)malloc((nverts+1)*sizeof(int));
+    int *adj = (int*)malloc(ilen*sizeof(int));
+    int *pos = (int*)malloc(nverts*sizeof(int));
+    float *vscore = (float*)malloc(nverts*sizeof(float));
+    float *uscore = (float*)malloc(nunits*sizeof(float));
+    char *emitted = (char*)calloc(nunits, 1);
+    GLushort *out = (GLushort*)malloc(ilen*sizeof(GLushort));
+    // units using each vertex
+    for (int i=0; i<ilen; i++)
+        ++valence[indices[i]];
+    start[0] = 0;
+    for (int v=0; v<nverts; v++)
+        start[v+1] = start[v]+valence[v];
+    memcpy(pos, start, nverts*sizeof(int));     // used as fill pointers first
+    for (int i=0; i<ilen; i++)
+        adj[pos[indices[i]]++] = i/usize;
+    for (int v=0; v<nverts; v++) {
+        pos[v] = -1;
+        vscore[v] = vertex_score(-1, valence[v]);
+    }
+    int best = -1;
+    float bestscore = -1.0f;
+    for (int u=0; u<nunits; u++) {
+        uscore[u] = 0.0f;
+        for (int c=0; c<usize; c++)
+            uscore[u] += vscore[indices[u*usize+c]];
+        if(uscore[u]>bestscore) {
+            bestscore = uscore[u];
+            best = u;
+        }
+    }
+    int cache[LISTWELD_CACHE+6];
+    int ncache = 0;
+    int scan = 0;
+    for (int done=0; done<nunits; done++) {
+        if(best<0) {
+            // nothing left around the cache, take the next unit not emitted yet
+            while(emitted[scan]) ++scan;
+            best = scan;
+        }
+        const GLushort *unit = indices+best*usize;
+        emitted[best] = 1;
+        memcpy(out+done*usize, unit, usize*sizeof(GLushort));
+        // the unit is not using its vertices anymore
+        for (int c=0; c<usize; c++) {
+            const int v = unit[c];
+            int *a = adj+start[v];
+            for (int j=0; j<valence[v]; j++)
+                if(a[j]==best) {
+                    a[j] = a[--valence[v]];
+                    break;
+                }
+        }
+        // new cache: the vertices of the unit in front, then the previous content
+        int newcache[LISTWELD_CACHE+6];
+        int n = 0;
+        for (int c=0; c<usize; c++) {
+            int j;
+            for (j=0; j<n && newcache[j]!=unit[c]; j++);
+            if(j==n)
+                newcache[n++] = unit[c];
+        }
+        const int nunit = n;
+        for (int i=0; i<ncache; i++) {
+            int j;
+            for (j=0; j<nunit && newcache[j]!=cache[i]; j++);
+            if(j==nunit)
+                newcache[n++] = cache[i];
+        }
+        for (int i=0; i<n; i++)
+            pos[newcache[i]] = (i<LISTWELD_CACHE)?i:-1;
+        // update the scores around the cache, and pick the best next unit there
+        for (int i=0; i<n; i++)
+            vscore[newcache[i]] = vertex_score(pos[newcache[i]], valence[newcache[i]]);
+        best = -1;
+        bestscore = -1.0f;
+        for (int i=0; i<n; i++) {
+            const int v = newcache[i];
+            for (int j=0; j<valence[v]; j++) {
+                const int u = adj[start[v]+j];
+                float s = 0.0f;
+                for (int c=0; c<usize; c++)
+                    s += vscore[indices[u*usize+c]];
+                uscore[u] = s;
+                if(s>bestscore) {
+                    bestscore = s;
+                    best = u;
+                }
+            }
+        }
+        ncache = (n>LISTWELD_CACHE)?LISTWELD_CACHE:n;
+        memcpy(cache, newcache, ncache*sizeof(int));
+    }
+    memcpy(indices, out, ilen*sizeof(GLushort));
+    free(out);
+    free(emitted);
+    free(uscore);
+    free(vscore);
+    free(pos);
+    free(adj);
+    free(start);
+    free(valence);
+}
+
+// number of triangles per reordered unit, 0 if the list cannot be reordered
+static int reorder_unit(GLenum mode_init) {
+    switch(mode_init) {
+        case GL_TRIANGLES:
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN:
+            return 1;
+        case GL_QUADS:
+            return 2;   // keep the 2 triangles of a quad together, for the GL_LINE polygon mode
+    }
+    return 0;
+}
+
+static int get_reorder_unit(renderlist_t *list) {
+    if(!list->mode_inits)
+        return reorder_unit(list->mode_init);
+    // merged lists: the segments must all be of the same kind
+    const int k = reorder_unit(list->mode_inits[0].mode_init);
+    if(!k)
+        return 0;
+    for (int i=0; i<list->mode_init_len; i++)
+        if(reorder_unit(list->mode_inits[i].mode_init)!=k || (list->mode_inits[i].ilen%(3*k)))
+            return 0;
+    return k;
+}
+
+void listweld_renderlist(renderlist_t *list) {
+    if(list->mode!=GL_TRIANGLES || list->len<3 || list->len>65536 || !list->vert || list->use_glstate || list->ind_lines || list->final_colors
+        || (list->shared_arrays && (*list->shared_arrays)>0) || (list->shared_indices && (*list->shared_indices)>0))
+        return;
+    const int len = list->len;
+    listweld_attrib_t attribs[5+MAX_TEX];
+    const int nattribs = get_attribs(list, attribs);
+    // find the duplicates: remap[i] is the index of vertex i once welded
+    int hsize = 64;
+    while(hsize<len*2) hsize<<=1;
+    int *table = (int*)malloc(hsize*sizeof(int));   // first occurrence of a vertex, -1 if empty
+    memset(table, 0xff, hsize*sizeof(int));
+    GLushort *remap = (GLushort*)malloc(len*sizeof(GLushort));
+    int nuniq = 0;
+    for (int i=0; i<len; i++) {
+        uint32_t h = hash_vertex(attribs, nattribs, i)&(hsize-1);
+        while(table[h]>=0 && !same_vertex(attribs, nattribs, table[h], i))
+            h = (h+1)&(hsize-1);
+        if(table[h]<0) {
+            table[h] = i;
+            remap[i] = nuniq++;
+        } else
+            remap[i] = remap[table[h]];
+    }
+    free(table);
+    // not indexed yet: indices cost 2 bytes per vertex, only weld if it saves enough
+    if(nuniq<len && (list->indices || nuniq*8<=len*7)) {
+        // compact the arrays, the first occurrences keep their order so it can be done in place
+        int n = 0;
+        for (int i=0; i<len; i++) {
+            if(remap[i]!=n)
+                continue;
+            if(i!=n)
+                for (int a=0; a<nattribs; a++)
+                    memcpy(attribs[a].data+n*attribs[a].stride, attribs[a].data+i*attribs[a].stride, attribs[a].n*sizeof(GLfloat));
+            ++n;
+        }
+        // remap (or create) the indices, same positions so the mode_inits are still valid
+        if(list->indices) {
+            for (int i=0; i<list->ilen; i++)
+                list->indices[i] = remap[list->indices[i]];
+        } else {
+            list->indices = (GLushort*)listpool_alloc(len*sizeof(GLushort));
+            list->indice_cap = listpool_blocksize(len*sizeof(GLushort))/sizeof(GLushort);
+            memcpy(list->indices, remap, len*sizeof(GLushort));
+            list->ilen = len;
+        }
+        COUNTER_ADD(listweld_vertices, len-nuniq);
+        DBG(SHUT_LOGD("listweld: list %u, %d => %d vertices\n", list->name, len, nuniq);)
+        list->len = nuniq;
+    }
+    free(remap);
+    if(globals4es.listweld>1 && list->indices) {
+        const int k = get_reorder_unit(list);
+        if(k)
+            reorder_triangles(list->indices, list->ilen, list->len, k);
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef _GL4ES_LISTWELD_H_
+#define _GL4ES_LISTWELD_H_
+
+#include "list.h"
+
+// Vertex welding of display lists (see LIBGL_LISTWELD)
+// When a compiled GL_TRIANGLES renderlist is closed, identical vertices (all attributes bit for bit equal)
+// are merged, the arrays are compacted and the list becomes indexed, keeping the order of the triangles.
+// With LIBGL_LISTWELD=2, the triangles are also reordered for the post-transform vertex cache
+// (Forsyth's linear speed algorithm), changing the drawing order inside the list.
+
+#define LISTWELD_CACHE  32      // vertex cache size simulated by the reordering
+
+// weld the vertices of a renderlist just closed by end_renderlist
+void listweld_renderlist(renderlist_t *list);
+
+#endif // _GL4ES_LISTWELD_H_
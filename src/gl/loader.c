@@ -1,4 +1,6 @@
 #include "loader.h"
+#include "hardstate.h"
+#include "nulldrv.h"
 
 void (APIENTRY_GL4ES *gl4es_getMainFBSize)(GLint* width, GLint* height);
 
@@ -169,6 +171,10 @@ void load_libs() {
     static int first = 1;
     if (! first) return;
     first = 0;
+    if(globals4es.nulldriver) {
+        gles = egl = nulldrv_init(globals4es.nulldriver);
+        return;
+    }
 #ifndef _WIN32
     const char *gles_override = globals4es.force_gles_lib?globals4es.force_gles_lib:GetEnvVar("LIBGL_GLES");
     if (!gles_override) {
@@ -214,7 +220,9 @@ void load_libs() {
 // user-defined getProcAddress
 void* (APIENTRY_GL4ES *gles_getProcAddress)(const char *name);
 
-void* APIENTRY_GL4ES proc_address(void *lib, const char *name) {
+static void* raw_proc_address(void *lib, const char *name) {
+    if (globals4es.nulldriver)
+        return nulldrv_GetProcAddress(name);
     if (gles_getProcAddress)
         return gles_getProcAddress(name);
 #ifdef AMIGAOS4
@@ -232,3 +240,11 @@ void* APIENTRY_GL4ES proc_address(void *lib, const char *name) {
     return NULL;
 #endif
 }
+
+void* APIENTRY_GL4ES proc_address(void *lib, const char *name) {
+    void *proc = raw_proc_address(lib, name);
+    // state setting functions of the driver go through the state shadow
+    if (lib == gles)
+        return hardstate_hook(name, proc);
+    return proc;
+}
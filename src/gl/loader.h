@@ -120,14 +120,15 @@ EXPORT extern void *egl;
 #define MSVC_SPC(MACRO, ARGS) MACRO ARGS
 
 #define PUSH_IF_COMPILING_EXT(nam, ...)             \
-    if (glstate->list.active) {                     \
-        if (!glstate->list.pending) { \
+    if (glstate->list.active || glstate->list.pending) { \
+        if (glstate->list.pending)                  \
+            gl4es_flush();                          \
+        else {                                      \
             NewStage(glstate->list.active, STAGE_GLCALL);   \
             MSVC_SPC(push_##nam, (__VA_ARGS__));            \
-            noerrorShim();							\
+            noerrorShim();                          \
             return (nam##_RETURN)0;                 \
         }                                           \
-        else gl4es_flush();                               \
     }
 
 #define PUSH_IF_COMPILING(name) PUSH_IF_COMPILING_EXT(name, name##_ARG_NAMES)
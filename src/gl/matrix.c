@@ -15,10 +15,14 @@
 #define DBG(a)
 #endif
 
+// source of the matrix stack gens, never 0 so the derived matrices stamps (initialized to 0) are invalid at start
+static unsigned int matrix_serial = 0;
+
 void alloc_matrix(matrixstack_t **matrixstack, int depth) {
 	*matrixstack = (matrixstack_t*)malloc(sizeof(matrixstack_t));
 	(*matrixstack)->top = 0;
 	(*matrixstack)->identity = 0;
+	(*matrixstack)->gen = ++matrix_serial;
 	(*matrixstack)->stack = (GLfloat*)malloc(sizeof(GLfloat)*depth*16);
 }
 
@@ -54,6 +58,27 @@ static int update_current_identity(int I) {
 	}
 }
 
+// the current matrix changed: the derived matrices and the builtin uniforms that use it need to be computed / sent again
+static void dirty_current_mat() {
+	switch(glstate->matrix_mode) {
+		case GL_MODELVIEW:
+			glstate->modelview_matrix->gen = ++matrix_serial;
+			DIRTY_UNIFORMS(UG_MODELVIEW);
+			break;
+		case GL_PROJECTION:
+			glstate->projection_matrix->gen = ++matrix_serial;
+			DIRTY_UNIFORMS(UG_PROJECTION);
+			break;
+		case GL_TEXTURE:
+			glstate->texture_matrix[glstate->texture.active]->gen = ++matrix_serial;
+			DIRTY_UNIFORMS(UG_TEXMATRIX);
+			break;
+		default:
+			if(glstate->matrix_mode>=GL_MATRIX0_ARB && glstate->matrix_mode<GL_MATRIX0_ARB+MAX_ARB_MATRIX)
+				glstate->arb_matrix[glstate->matrix_mode-GL_MATRIX0_ARB]->gen = ++matrix_serial;
+	}
+}
+
 static int send_to_hardware() {
 	if(hardext.esversion>1)
 		return 0;
@@ -81,14 +106,13 @@ DBG(SHUT_LOGD("init_matrix(%p)\n", glstate);)
 	glstate->modelview_matrix->identity = 1;
 	glstate->texture_matrix = (matrixstack_t**)malloc(sizeof(matrixstack_t*)*MAX_TEX);
 	glstate->arb_matrix = (matrixstack_t**)malloc(sizeof(matrixstack_t*)*MAX_ARB_MATRIX);
-	set_identity(glstate->mvp_matrix);
-	glstate->mvp_matrix_dirty = 0;
-	set_identity(glstate->inv_mv_matrix);
-	glstate->inv_mv_matrix_dirty = 0;
-	// no identity function for 3x3 matrix
-	memset(glstate->normal_matrix, 0, 9*sizeof(GLfloat));
-	glstate->normal_matrix[0] = glstate->normal_matrix[4] = glstate->normal_matrix[8] = 1.0f;
-	glstate->normal_matrix_dirty = 1;
+	// the derived matrices will be computed on first use
+	glstate->mvp_matrix_gen[0] = glstate->mvp_matrix_gen[1] = 0;
+	glstate->inv_mvp_matrix_gen[0] = glstate->inv_mvp_matrix_gen[1] = 0;
+	glstate->inv_mv_matrix_gen = 0;
+	glstate->normal_matrix_gen = 0;
+	glstate->inv_p_matrix_gen = 0;
+	memset(glstate->inv_tex_matrix_gen, 0, sizeof(glstate->inv_tex_matrix_gen));
     for (int i=0; i<MAX_TEX; i++) {
         alloc_matrix(&glstate->texture_matrix[i], MAX_STACK_TEXTURE);
         set_identity(TOP(texture_matrix[i]));
@@ -183,20 +207,22 @@ DBG(SHUT_LOGD("glPopMatrix(), list=%p\n", glstate->list.active);)
 	// go...
 	noerrorShim();
 	switch(matrix_mode) {
+		// nothing changes if the pop'd matrix is the same as the actual one (common with Push / Load same / Pop)
 		#define P(A) if(glstate->A->top) { \
-			--glstate->A->top; \
-			glstate->A->identity = is_identity(update_current_mat()); \
-			if (send_to_hardware()) {LOAD_GLES(glLoadMatrixf); gles_glLoadMatrixf(update_current_mat()); } \
+			if(memcmp(TOP(A)-16, TOP(A), 16*sizeof(GLfloat))==0) \
+				--glstate->A->top; \
+			else { \
+				--glstate->A->top; \
+				glstate->A->identity = is_identity(update_current_mat()); \
+				dirty_current_mat(); \
+				if (send_to_hardware()) {LOAD_GLES(glLoadMatrixf); gles_glLoadMatrixf(update_current_mat()); } \
+			} \
 		} else errorShim(GL_STACK_UNDERFLOW)
 		case GL_PROJECTION:
 			P(projection_matrix);
-			glstate->mvp_matrix_dirty = 1;
 			break;
 		case GL_MODELVIEW:
 			P(modelview_matrix);
-			glstate->mvp_matrix_dirty = 1;
-			glstate->inv_mv_matrix_dirty = 1;
-			glstate->normal_matrix_dirty = 1;
 			break;
 		case GL_TEXTURE:
 			P(texture_matrix[glstate->texture.active]);
@@ -218,22 +244,20 @@ DBG(SHUT_LOGD("glPopMatrix(), list=%p\n", glstate->list.active);)
 
 void APIENTRY_GL4ES gl4es_glLoadMatrixf(const GLfloat * m) {
 DBG(SHUT_LOGD("glLoadMatrix(%f, %f, %f, %f, %f, %f, %f...), list=%p\n", m[0], m[1], m[2], m[3], m[4], m[5], m[6], glstate->list.active);)
+	FLUSH_BEGINEND;
 	if (glstate->list.active) {
-		if(glstate->list.pending) gl4es_flush();
-		else {
-			NewStage(glstate->list.active, STAGE_MATRIX);
-			glstate->list.active->matrix_op = 1;
-			memcpy(glstate->list.active->matrix_val, m, 16*sizeof(GLfloat));
-			return;
-		}
+		NewStage(glstate->list.active, STAGE_MATRIX);
+		glstate->list.active->matrix_op = 1;
+		memcpy(glstate->list.active->matrix_val, m, 16*sizeof(GLfloat));
+		return;
 	}
-	memcpy(update_current_mat(), m, 16*sizeof(GLfloat));
+	GLfloat *current_mat = update_current_mat();
+	if(current_mat && memcmp(current_mat, m, 16*sizeof(GLfloat))==0)
+		return;	// same matrix, keep the derived ones
+	memcpy(current_mat, m, 16*sizeof(GLfloat));
 	const int id = update_current_identity(0);
-	if(glstate->matrix_mode==GL_MODELVIEW)
-		glstate->normal_matrix_dirty = glstate->inv_mv_matrix_dirty = 1;
-	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION)
-		glstate->mvp_matrix_dirty = 1;
-	else if((glstate->matrix_mode==GL_TEXTURE) && glstate->fpe_state)
+	dirty_current_mat();
+	if((glstate->matrix_mode==GL_TEXTURE) && glstate->fpe_state)
 		set_fpe_textureidentity();
     if(send_to_hardware()) {
 		LOAD_GLES(glLoadMatrixf);
@@ -245,28 +269,23 @@ DBG(SHUT_LOGD("glLoadMatrix(%f, %f, %f, %f, %f, %f, %f...), list=%p\n", m[0], m[
 
 void APIENTRY_GL4ES gl4es_glMultMatrixf(const GLfloat * m) {
 DBG(SHUT_LOGD("glMultMatrix(%f, %f, %f, %f, %f, %f, %f...), list=%p\n", m[0], m[1], m[2], m[3], m[4], m[5], m[6], glstate->list.active);)
+	FLUSH_BEGINEND;
 	if (glstate->list.active) {
-		if(glstate->list.pending) gl4es_flush();
-		else {
-			if(glstate->list.active->stage == STAGE_MATRIX) {
-				// multiply the matrix mith the current one....
-				matrix_mul(glstate->list.active->matrix_val, m, glstate->list.active->matrix_val);
-				return;
-			}
-			NewStage(glstate->list.active, STAGE_MATRIX);
-			glstate->list.active->matrix_op = 2;
-			memcpy(glstate->list.active->matrix_val, m, 16*sizeof(GLfloat));
+		if(glstate->list.active->stage == STAGE_MATRIX) {
+			// multiply the matrix mith the current one....
+			matrix_mul(glstate->list.active->matrix_val, m, glstate->list.active->matrix_val);
 			return;
 		}
+		NewStage(glstate->list.active, STAGE_MATRIX);
+		glstate->list.active->matrix_op = 2;
+		memcpy(glstate->list.active->matrix_val, m, 16*sizeof(GLfloat));
+		return;
 	}
 	GLfloat *current_mat = update_current_mat();
 	matrix_mul(current_mat, m, current_mat);
 	const int id = update_current_identity(0);
-	if(glstate->matrix_mode==GL_MODELVIEW)
-		glstate->normal_matrix_dirty = glstate->inv_mv_matrix_dirty = 1;
-	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION)
-		glstate->mvp_matrix_dirty = 1;
-	else if((glstate->matrix_mode==GL_TEXTURE) && glstate->fpe_state)
+	dirty_current_mat();
+	if((glstate->matrix_mode==GL_TEXTURE) && glstate->fpe_state)
 		set_fpe_textureidentity();
 	DBG(SHUT_LOGD(" => (%f, %f, %f, %f, %f, %f, %f...)\n", current_mat[0], current_mat[1], current_mat[2], current_mat[3], current_mat[4], current_mat[5], current_mat[6]);)
 	if(send_to_hardware()) {
@@ -279,22 +298,20 @@ DBG(SHUT_LOGD("glMultMatrix(%f, %f, %f, %f, %f, %f, %f...), list=%p\n", m[0], m[
 
 void APIENTRY_GL4ES gl4es_glLoadIdentity(void) {
 DBG(SHUT_LOGD("glLoadIdentity(), list=%p\n", glstate->list.active);)
+	FLUSH_BEGINEND;
 	if (glstate->list.active) {
-		if(glstate->list.pending) gl4es_flush();
-		else {
-			NewStage(glstate->list.active, STAGE_MATRIX);
-			glstate->list.active->matrix_op = 1;
-			set_identity(glstate->list.active->matrix_val);
-			return;
-		}
+		NewStage(glstate->list.active, STAGE_MATRIX);
+		glstate->list.active->matrix_op = 1;
+		set_identity(glstate->list.active->matrix_val);
+		return;
 	}
-	set_identity(update_current_mat());
+	GLfloat *current_mat = update_current_mat();
+	if(current_mat && is_identity(current_mat))
+		return;	// already identity, keep the derived ones
+	set_identity(current_mat);
 	update_current_identity(1);
-	if(glstate->matrix_mode==GL_MODELVIEW)
-		glstate->normal_matrix_dirty = glstate->inv_mv_matrix_dirty = 1;
-	if(glstate->matrix_mode==GL_MODELVIEW || glstate->matrix_mode==GL_PROJECTION)
-		glstate->mvp_matrix_dirty = 1;
-	else if((glstate->matrix_mode==GL_TEXTURE) && glstate->fpe_state)
+	dirty_current_mat();
+	if((glstate->matrix_mode==GL_TEXTURE) && glstate->fpe_state)
 		set_fpe_textureidentity();
 	if(send_to_hardware()) {
 		LOAD_GLES(glLoadIdentity);
@@ -19,6 +19,9 @@ void APIENTRY_GL4ES gl4es_glRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat
 void APIENTRY_GL4ES gl4es_glOrthof(GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat nearVal, GLfloat farVal);
 void APIENTRY_GL4ES gl4es_glFrustumf(GLfloat left,	GLfloat right, GLfloat bottom, GLfloat top,	GLfloat nearVal, GLfloat farVal);
 
+// The derived matrices are computed only when one of their source stack changed since the last time
+// (each stack has a gen, bumped when its top matrix changes, and each derived matrix keep the gen(s) it was computed from)
+
 static inline GLfloat* getTexMat(int tmu) {
 	return glstate->texture_matrix[tmu]->stack+glstate->texture_matrix[tmu]->top*16;
 }
@@ -27,33 +30,61 @@ static inline GLfloat* getMVMat() {
 	return glstate->modelview_matrix->stack+glstate->modelview_matrix->top*16;
 }
 
+static inline GLfloat* getPMat() {
+	return glstate->projection_matrix->stack+glstate->projection_matrix->top*16;
+}
+
 static inline GLfloat* getInvMVMat() {
-	if(glstate->inv_mv_matrix_dirty) {
-		matrix_inverse(glstate->modelview_matrix->stack+glstate->modelview_matrix->top*16, glstate->inv_mv_matrix);
-		glstate->inv_mv_matrix_dirty = 0;
+	if(glstate->inv_mv_matrix_gen != glstate->modelview_matrix->gen) {
+		matrix_inverse(getMVMat(), glstate->inv_mv_matrix);
+		glstate->inv_mv_matrix_gen = glstate->modelview_matrix->gen;
 	}
 	return glstate->inv_mv_matrix;
 }
+
 static inline GLfloat* getNormalMat() {
-	if(glstate->normal_matrix_dirty) {
-		matrix_inverse3_transpose(glstate->modelview_matrix->stack+glstate->modelview_matrix->top*16, glstate->normal_matrix);
-		glstate->normal_matrix_dirty = 0;
+	if(glstate->normal_matrix_gen != glstate->modelview_matrix->gen) {
+		matrix_inverse3_transpose(getMVMat(), glstate->normal_matrix);
+		glstate->normal_matrix_gen = glstate->modelview_matrix->gen;
 	}
 	return glstate->normal_matrix;
 }
 
-static inline GLfloat* getPMat() {
-	return glstate->projection_matrix->stack+glstate->projection_matrix->top*16;
+static inline GLfloat* getInvPMat() {
+	if(glstate->inv_p_matrix_gen != glstate->projection_matrix->gen) {
+		matrix_inverse(getPMat(), glstate->inv_p_matrix);
+		glstate->inv_p_matrix_gen = glstate->projection_matrix->gen;
+	}
+	return glstate->inv_p_matrix;
+}
+
+static inline GLfloat* getInvTexMat(int tmu) {
+	if(glstate->inv_tex_matrix_gen[tmu] != glstate->texture_matrix[tmu]->gen) {
+		matrix_inverse(getTexMat(tmu), glstate->inv_tex_matrix[tmu]);
+		glstate->inv_tex_matrix_gen[tmu] = glstate->texture_matrix[tmu]->gen;
+	}
+	return glstate->inv_tex_matrix[tmu];
 }
 
 static inline GLfloat* getMVPMat()
 {
-	if(glstate->mvp_matrix_dirty) {
+	if(glstate->mvp_matrix_gen[0] != glstate->modelview_matrix->gen || glstate->mvp_matrix_gen[1] != glstate->projection_matrix->gen) {
 		matrix_mul(getPMat(), getMVMat(), glstate->mvp_matrix);
-		glstate->mvp_matrix_dirty = 0;
+		glstate->mvp_matrix_gen[0] = glstate->modelview_matrix->gen;
+		glstate->mvp_matrix_gen[1] = glstate->projection_matrix->gen;
 	}
 	return glstate->mvp_matrix;
 }
 
+static inline GLfloat* getInvMVPMat()
+{
+	if(glstate->inv_mvp_matrix_gen[0] != glstate->modelview_matrix->gen || glstate->inv_mvp_matrix_gen[1] != glstate->projection_matrix->gen) {
+		matrix_inverse(getMVPMat(), glstate->inv_mvp_matrix);
+		glstate->inv_mvp_matrix_gen[0] = glstate->modelview_matrix->gen;
+		glstate->inv_mvp_matrix_gen[1] = glstate->projection_matrix->gen;
+	}
+	return glstate->inv_mvp_matrix;
+}
+
 
 #endif // _GL4ES_MATRIX_H_
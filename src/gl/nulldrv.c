@@ -0,0 +1,884 @@
+#include "nulldrv.h"
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gles.h"
+#include "wrap/gles.h"
+#include "const.h"
+#include "enum_info.h"
+#include "logs.h"
+#ifndef NOEGL
+#include <EGL/egl.h>
+#endif
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+// size of the call log ring (must be a power of 2)
+#define NULLDRV_LOG_SIZE    (1<<16)
+// size of the fake default framebuffer
+#define NULLDRV_WIDTH       1280
+#define NULLDRV_HEIGHT      720
+
+enum {
+#define _NOOP(name) NULLDRV_##name,
+#define _IMPL(name) NULLDRV_##name,
+#include "nulldrvfuncs.inc"
+#undef _NOOP
+#undef _IMPL
+    NULLDRV_FRAME,      // pseudo-call, marks a eglSwapBuffers in the log
+    NULLDRV_COUNT
+};
+
+static const char* nulldrv_names[NULLDRV_COUNT] = {
+#define _NOOP(name) #name,
+#define _IMPL(name) #name,
+#include "nulldrvfuncs.inc"
+#undef _NOOP
+#undef _IMPL
+    "eglSwapBuffers",
+};
+
+// uniform reported by a linked program
+typedef struct {
+    char        *name;
+    GLenum      type;
+    GLint       size;
+    GLint       location;   // arrays use 1 location per element
+} nulldrv_uniform_t;
+
+// shader or program
+typedef struct {
+    GLuint              id;
+    char                *source;        // shader
+    GLuint              *shaders;       // program: attached shaders
+    int                 nshaders;
+    nulldrv_uniform_t   *uniforms;      // program: uniforms declared in the shaders at link time
+    int                 nuniforms;
+    GLint               maxlength;      // longest uniform name (with "[0]" for arrays and the '\0')
+} nulldrv_object_t;
+
+typedef struct {
+    int                     mode;
+    gl4es_nulldrv_stats_t   stats;
+    unsigned long long      calls[NULLDRV_COUNT];
+    unsigned short          *log;
+    unsigned int            log_pos;
+    GLuint                  names;      // last generated object name
+    nulldrv_object_t        *objects;   // shaders and programs
+    int                     nobjects;
+} nulldrv_t;
+
+static nulldrv_t nulldrv = {0};
+
+static inline void nulldrv_record(int id) {
+    ++nulldrv.calls[id];
+    ++nulldrv.stats.calls;
+    if(nulldrv.log)
+        nulldrv.log[(nulldrv.log_pos++)&(NULLDRV_LOG_SIZE-1)] = id;
+}
+
+static void nulldrv_gen(GLsizei n, GLuint *ids) {
+    for (int i=0; i<n; ++i)
+        ids[i] = ++nulldrv.names;
+}
+
+static int nulldrv_getinteger(GLenum pname, GLint *params) {
+    switch(pname) {
+        case GL_VIEWPORT:
+        case GL_SCISSOR_BOX:
+            params[0] = 0; params[1] = 0;
+            params[2] = NULLDRV_WIDTH; params[3] = NULLDRV_HEIGHT;
+            return 4;
+        case GL_MAX_VIEWPORT_DIMS:
+            params[0] = params[1] = 4096;
+            return 2;
+        case GL_MAX_TEXTURE_SIZE:
+        case GL_MAX_RENDERBUFFER_SIZE:
+        case GL_MAX_CUBE_MAP_TEXTURE_SIZE_OES:
+            params[0] = 4096;
+            return 1;
+        case GL_MAX_TEXTURE_UNITS:
+        case GL_MAX_DRAW_BUFFERS_ARB:
+        case GL_MAX_COLOR_ATTACHMENTS:
+            params[0] = 4;
+            return 1;
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_VERTEX_ATTRIBS:
+        case GL_MAX_VARYING_VECTORS:
+            params[0] = 16;
+            return 1;
+        case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+            params[0] = 32;
+            return 1;
+        case GL_MAX_VERTEX_UNIFORM_VECTORS:
+        case GL_MAX_FRAGMENT_UNIFORM_VECTORS:
+            params[0] = 256;
+            return 1;
+        case GL_MAX_LIGHTS:
+            params[0] = 8;
+            return 1;
+        case GL_MAX_CLIP_PLANES:
+            params[0] = 6;
+            return 1;
+        case GL_RED_BITS:
+        case GL_GREEN_BITS:
+        case GL_BLUE_BITS:
+        case GL_ALPHA_BITS:
+        case GL_STENCIL_BITS:
+            params[0] = 8;
+            return 1;
+        case GL_DEPTH_BITS:
+            params[0] = 24;
+            return 1;
+        case GL_IMPLEMENTATION_COLOR_READ_FORMAT_OES:
+            params[0] = GL_RGBA;
+            return 1;
+        case GL_IMPLEMENTATION_COLOR_READ_TYPE_OES:
+            params[0] = GL_UNSIGNED_BYTE;
+            return 1;
+        default:
+            params[0] = 0;
+            return 1;
+    }
+}
+
+// No-op entry points
+#define _NOOP(name) \
+    static void APIENTRY_GLES nulldrv_##name(name##_ARG_EXPAND) { nulldrv_record(NULLDRV_##name); }
+#define _IMPL(name)
+#include "nulldrvfuncs.inc"
+#undef _NOOP
+#undef _IMPL
+
+// Entry points that need to return something or account data
+#define NULLDRV_GEN(name) \
+    static void APIENTRY_GLES nulldrv_##name(GLsizei n, GLuint *ids) { nulldrv_record(NULLDRV_##name); nulldrv_gen(n, ids); }
+NULLDRV_GEN(glGenBuffers)
+NULLDRV_GEN(glGenFramebuffers)
+NULLDRV_GEN(glGenRenderbuffers)
+NULLDRV_GEN(glGenSamplers)
+NULLDRV_GEN(glGenTextures)
+#undef NULLDRV_GEN
+
+#define NULLDRV_IS(name) \
+    static GLboolean APIENTRY_GLES nulldrv_##name(GLuint id) { nulldrv_record(NULLDRV_##name); return id?GL_TRUE:GL_FALSE; }
+NULLDRV_IS(glIsBuffer)
+NULLDRV_IS(glIsFramebuffer)
+NULLDRV_IS(glIsProgram)
+NULLDRV_IS(glIsRenderbuffer)
+NULLDRV_IS(glIsShader)
+NULLDRV_IS(glIsTexture)
+#undef NULLDRV_IS
+
+// Get with an unknown number of values: only the 1st is cleared
+#define NULLDRV_GET1(name, type) \
+    static void APIENTRY_GLES nulldrv_##name(name##_ARG_EXPAND) { nulldrv_record(NULLDRV_##name); *(type*)params = 0; }
+NULLDRV_GET1(glGetBufferParameteriv, GLint)
+NULLDRV_GET1(glGetFixedv, GLfixed)
+NULLDRV_GET1(glGetFramebufferAttachmentParameteriv, GLint)
+NULLDRV_GET1(glGetLightfv, GLfloat)
+NULLDRV_GET1(glGetLightxv, GLfixed)
+NULLDRV_GET1(glGetMaterialfv, GLfloat)
+NULLDRV_GET1(glGetMaterialxv, GLfixed)
+NULLDRV_GET1(glGetRenderbufferParameteriv, GLint)
+NULLDRV_GET1(glGetTexEnvfv, GLfloat)
+NULLDRV_GET1(glGetTexEnviv, GLint)
+NULLDRV_GET1(glGetTexEnvxv, GLfixed)
+NULLDRV_GET1(glGetTexLevelParameteriv, GLint)
+NULLDRV_GET1(glGetTexParameterfv, GLfloat)
+NULLDRV_GET1(glGetTexParameteriv, GLint)
+NULLDRV_GET1(glGetTexParameterxv, GLfixed)
+NULLDRV_GET1(glGetUniformfv, GLfloat)
+NULLDRV_GET1(glGetUniformiv, GLint)
+NULLDRV_GET1(glGetVertexAttribfv, GLfloat)
+NULLDRV_GET1(glGetVertexAttribiv, GLint)
+#undef NULLDRV_GET1
+
+static void APIENTRY_GLES nulldrv_glGetClipPlanef(GLenum plane, GLfloat *equation) {
+    nulldrv_record(NULLDRV_glGetClipPlanef);
+    memset(equation, 0, 4*sizeof(GLfloat));
+}
+static void APIENTRY_GLES nulldrv_glGetClipPlanex(GLenum plane, GLfixed *equation) {
+    nulldrv_record(NULLDRV_glGetClipPlanex);
+    memset(equation, 0, 4*sizeof(GLfixed));
+}
+static void APIENTRY_GLES nulldrv_glGetPointerv(GLenum pname, GLvoid **params) {
+    nulldrv_record(NULLDRV_glGetPointerv);
+    *params = NULL;
+}
+static void APIENTRY_GLES nulldrv_glGetVertexAttribPointerv(GLuint index, GLenum pname, GLvoid **pointer) {
+    nulldrv_record(NULLDRV_glGetVertexAttribPointerv);
+    *pointer = NULL;
+}
+
+static void APIENTRY_GLES nulldrv_glGetIntegerv(GLenum pname, GLint *params) {
+    nulldrv_record(NULLDRV_glGetIntegerv);
+    nulldrv_getinteger(pname, params);
+}
+static void APIENTRY_GLES nulldrv_glGetFloatv(GLenum pname, GLfloat *params) {
+    nulldrv_record(NULLDRV_glGetFloatv);
+    GLint tmp[4];
+    int n = nulldrv_getinteger(pname, tmp);
+    for (int i=0; i<n; ++i)
+        params[i] = tmp[i];
+}
+static void APIENTRY_GLES nulldrv_glGetBooleanv(GLenum pname, GLboolean *params) {
+    nulldrv_record(NULLDRV_glGetBooleanv);
+    GLint tmp[4];
+    int n = nulldrv_getinteger(pname, tmp);
+    for (int i=0; i<n; ++i)
+        params[i] = tmp[i]?GL_TRUE:GL_FALSE;
+}
+static GLboolean APIENTRY_GLES nulldrv_glIsEnabled(GLenum cap) {
+    nulldrv_record(NULLDRV_glIsEnabled);
+    return GL_FALSE;
+}
+static GLenum APIENTRY_GLES nulldrv_glGetError() {
+    nulldrv_record(NULLDRV_glGetError);
+    return GL_NO_ERROR;
+}
+static const GLubyte* APIENTRY_GLES nulldrv_glGetString(GLenum name) {
+    nulldrv_record(NULLDRV_glGetString);
+    switch(name) {
+        case GL_VENDOR: return (const GLubyte*)"gl4es";
+        case GL_RENDERER: return (const GLubyte*)"gl4es null driver";
+        case GL_VERSION: return (const GLubyte*)"OpenGL ES 3.2 null";
+        case GL_SHADING_LANGUAGE_VERSION: return (const GLubyte*)"OpenGL ES GLSL ES 3.20";
+        case GL_EXTENSIONS: return (const GLubyte*)"GL_OES_element_index_uint GL_OES_packed_depth_stencil GL_OES_depth24 GL_OES_rgb8_rgba8 GL_EXT_texture_format_BGRA8888 GL_OES_depth_texture GL_OES_texture_npot ";
+    }
+    return NULL;
+}
+static GLenum APIENTRY_GLES nulldrv_glCheckFramebufferStatus(GLenum target) {
+    nulldrv_record(NULLDRV_glCheckFramebufferStatus);
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+// Shaders & Programs: everything compiles and links, with no active attribute
+// The uniforms declared in the shaders are active, with locations given in declaration order
+static nulldrv_object_t* nulldrv_newobject() {
+    nulldrv.objects = (nulldrv_object_t*)realloc(nulldrv.objects, (nulldrv.nobjects+1)*sizeof(nulldrv_object_t));
+    nulldrv_object_t *o = nulldrv.objects+nulldrv.nobjects++;
+    memset(o, 0, sizeof(nulldrv_object_t));
+    o->id = ++nulldrv.names;
+    return o;
+}
+static nulldrv_object_t* nulldrv_getobject(GLuint id) {
+    for (int i=nulldrv.nobjects-1; i>=0; --i)
+        if(nulldrv.objects[i].id==id)
+            return nulldrv.objects+i;
+    return NULL;
+}
+static void nulldrv_freeuniforms(nulldrv_object_t *o) {
+    for (int i=0; i<o->nuniforms; ++i)
+        free(o->uniforms[i].name);
+    free(o->uniforms);
+    o->uniforms = NULL;
+    o->nuniforms = 0;
+    o->maxlength = 0;
+}
+static void nulldrv_deleteobject(GLuint id) {
+    nulldrv_object_t *o = nulldrv_getobject(id);
+    if(!o)
+        return;
+    free(o->source);
+    free(o->shaders);
+    nulldrv_freeuniforms(o);
+    *o = nulldrv.objects[--nulldrv.nobjects];
+}
+
+// next token of a GLSL source (identifier, number or 1 char), skipping blanks, comments and preprocessor lines
+static const char* nulldrv_token(const char *p, char *tok, int max) {
+    while(1) {
+        while(isspace((unsigned char)*p)) ++p;
+        if(p[0]=='/' && p[1]=='*') {
+            const char *e = strstr(p+2, "*/");
+            p = e?(e+2):(p+strlen(p));
+        } else if((p[0]=='/' && p[1]=='/') || p[0]=='#') {
+            while(*p && *p!='\n') ++p;
+        } else
+            break;
+    }
+    int n = 0;
+    if(isalnum((unsigned char)*p) || *p=='_') {
+        for (; isalnum((unsigned char)*p) || *p=='_'; ++p)
+            if(n<max-1) tok[n++] = *p;
+    } else if(*p)
+        tok[n++] = *p++;
+    tok[n] = '\0';
+    return p;
+}
+// value of a "#define name value", for the size of uniform arrays
+static int nulldrv_define(const char *source, const char *name) {
+    for (const char *p = strstr(source, "#define"); p; p = strstr(p+7, "#define")) {
+        char def[128];
+        int value;
+        if(sscanf(p+7, "%127s %d", def, &value)==2 && !strcmp(def, name))
+            return value;
+    }
+    return 1;
+}
+static GLenum nulldrv_uniformtype(const char *name) {
+    static const struct {
+        const char  *name;
+        GLenum      type;
+    } types[] = {
+        {"float", GL_FLOAT}, {"vec2", GL_FLOAT_VEC2}, {"vec3", GL_FLOAT_VEC3}, {"vec4", GL_FLOAT_VEC4},
+        {"int", GL_INT}, {"ivec2", GL_INT_VEC2}, {"ivec3", GL_INT_VEC3}, {"ivec4", GL_INT_VEC4},
+        {"bool", GL_BOOL}, {"bvec2", GL_BOOL_VEC2}, {"bvec3", GL_BOOL_VEC3}, {"bvec4", GL_BOOL_VEC4},
+        {"mat2", GL_FLOAT_MAT2}, {"mat3", GL_FLOAT_MAT3}, {"mat4", GL_FLOAT_MAT4},
+        {"sampler2D", GL_SAMPLER_2D}, {"samplerCube", GL_SAMPLER_CUBE}, {"sampler2DShadow", GL_SAMPLER_2D_SHADOW},
+    };
+    for (int i=0; i<sizeof(types)/sizeof(types[0]); ++i)
+        if(!strcmp(types[i].name, name))
+            return types[i].type;
+    return 0;   // uniform block or struct: not reported
+}
+static void nulldrv_adduniform(nulldrv_object_t *o, const char *name, GLenum type, GLint size) {
+    GLint location = 0;
+    for (int i=0; i<o->nuniforms; ++i) {
+        if(!strcmp(o->uniforms[i].name, name))
+            return;     // also declared in another shader
+        location = o->uniforms[i].location+o->uniforms[i].size;
+    }
+    o->uniforms = (nulldrv_uniform_t*)realloc(o->uniforms, (o->nuniforms+1)*sizeof(nulldrv_uniform_t));
+    nulldrv_uniform_t *u = o->uniforms+o->nuniforms++;
+    u->name = strdup(name);
+    u->type = type;
+    u->size = (size>0)?size:1;
+    u->location = location;
+    GLint len = strlen(name)+((u->size>1)?4:1);
+    if(o->maxlength<len)
+        o->maxlength = len;
+}
+// find the "uniform [precision] type name[size], ...;" declarations of a shader
+static void nulldrv_parseuniforms(nulldrv_object_t *o, const char *source) {
+    char tok[128], name[128];
+    const char *p = source;
+    while(*p) {
+        p = nulldrv_token(p, tok, sizeof(tok));
+        if(strcmp(tok, "uniform"))
+            continue;
+        do {
+            p = nulldrv_token(p, tok, sizeof(tok));
+        } while(!strcmp(tok, "lowp") || !strcmp(tok, "mediump") || !strcmp(tok, "highp"));
+        GLenum type = nulldrv_uniformtype(tok);
+        while(1) {
+            p = nulldrv_token(p, name, sizeof(name));
+            if(!isalpha((unsigned char)name[0]) && name[0]!='_')
+                break;
+            GLint size = 1;
+            p = nulldrv_token(p, tok, sizeof(tok));
+            if(tok[0]=='[') {
+                p = nulldrv_token(p, tok, sizeof(tok));
+                size = isdigit((unsigned char)tok[0])?atoi(tok):nulldrv_define(source, tok);
+                p = nulldrv_token(p, tok, sizeof(tok));     // ]
+                p = nulldrv_token(p, tok, sizeof(tok));
+            }
+            if(type)
+                nulldrv_adduniform(o, name, type, size);
+            if(tok[0]!=',')
+                break;
+        }
+    }
+}
+
+static GLuint APIENTRY_GLES nulldrv_glCreateProgram() {
+    nulldrv_record(NULLDRV_glCreateProgram);
+    return nulldrv_newobject()->id;
+}
+static GLuint APIENTRY_GLES nulldrv_glCreateShader(GLenum type) {
+    nulldrv_record(NULLDRV_glCreateShader);
+    return nulldrv_newobject()->id;
+}
+static void APIENTRY_GLES nulldrv_glDeleteProgram(GLuint program) {
+    nulldrv_record(NULLDRV_glDeleteProgram);
+    nulldrv_deleteobject(program);
+}
+static void APIENTRY_GLES nulldrv_glDeleteShader(GLuint shader) {
+    nulldrv_record(NULLDRV_glDeleteShader);
+    nulldrv_deleteobject(shader);
+}
+static void APIENTRY_GLES nulldrv_glShaderSource(GLuint shader, GLsizei count, const GLchar * const * string, const GLint * length) {
+    nulldrv_record(NULLDRV_glShaderSource);
+    nulldrv_object_t *o = nulldrv_getobject(shader);
+    if(!o)
+        return;
+    int size = 1;
+    for (int i=0; i<count; ++i)
+        size += (length && length[i]>=0)?length[i]:strlen(string[i]);
+    o->source = (char*)realloc(o->source, size);
+    o->source[0] = '\0';
+    for (int i=0; i<count; ++i)
+        strncat(o->source, string[i], (length && length[i]>=0)?length[i]:strlen(string[i]));
+}
+static void APIENTRY_GLES nulldrv_glAttachShader(GLuint program, GLuint shader) {
+    nulldrv_record(NULLDRV_glAttachShader);
+    nulldrv_object_t *o = nulldrv_getobject(program);
+    if(!o)
+        return;
+    o->shaders = (GLuint*)realloc(o->shaders, (o->nshaders+1)*sizeof(GLuint));
+    o->shaders[o->nshaders++] = shader;
+}
+static void APIENTRY_GLES nulldrv_glDetachShader(GLuint program, GLuint shader) {
+    nulldrv_record(NULLDRV_glDetachShader);
+    nulldrv_object_t *o = nulldrv_getobject(program);
+    if(!o)
+        return;
+    for (int i=0; i<o->nshaders; ++i)
+        if(o->shaders[i]==shader) {
+            o->shaders[i] = o->shaders[--o->nshaders];
+            break;
+        }
+}
+static void APIENTRY_GLES nulldrv_glLinkProgram(GLuint program) {
+    nulldrv_record(NULLDRV_glLinkProgram);
+    nulldrv_object_t *o = nulldrv_getobject(program);
+    if(!o)
+        return;
+    nulldrv_freeuniforms(o);
+    for (int i=0; i<o->nshaders; ++i) {
+        nulldrv_object_t *s = nulldrv_getobject(o->shaders[i]);
+        if(s && s->source)
+            nulldrv_parseuniforms(o, s->source);
+    }
+}
+static void APIENTRY_GLES nulldrv_glGetShaderiv(GLuint shader, GLenum pname, GLint *params) {
+    nulldrv_record(NULLDRV_glGetShaderiv);
+    *params = (pname==GL_COMPILE_STATUS)?GL_TRUE:0;
+}
+static void APIENTRY_GLES nulldrv_glGetProgramiv(GLuint program, GLenum pname, GLint *params) {
+    nulldrv_record(NULLDRV_glGetProgramiv);
+    nulldrv_object_t *o = nulldrv_getobject(program);
+    switch(pname) {
+        case GL_LINK_STATUS:
+        case GL_VALIDATE_STATUS:
+            *params = GL_TRUE; break;
+        case GL_ACTIVE_UNIFORMS:
+            *params = o?o->nuniforms:0; break;
+        case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+            *params = o?o->maxlength:0; break;
+        default:
+            *params = 0;
+    }
+}
+static void APIENTRY_GLES nulldrv_glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {
+    nulldrv_record(NULLDRV_glGetShaderInfoLog);
+    if(length) *length = 0;
+    if(bufSize>0 && infoLog) infoLog[0] = '\0';
+}
+static void APIENTRY_GLES nulldrv_glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {
+    nulldrv_record(NULLDRV_glGetProgramInfoLog);
+    if(length) *length = 0;
+    if(bufSize>0 && infoLog) infoLog[0] = '\0';
+}
+static void APIENTRY_GLES nulldrv_glGetShaderSource(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source) {
+    nulldrv_record(NULLDRV_glGetShaderSource);
+    if(length) *length = 0;
+    if(bufSize>0 && source) source[0] = '\0';
+}
+static void APIENTRY_GLES nulldrv_glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, GLvoid *binary) {
+    nulldrv_record(NULLDRV_glGetProgramBinary);
+    if(length) *length = 0;
+}
+static void APIENTRY_GLES nulldrv_glGetAttachedShaders(GLuint program, GLsizei maxCount, GLsizei *count, GLuint *obj) {
+    nulldrv_record(NULLDRV_glGetAttachedShaders);
+    if(count) *count = 0;
+}
+static void APIENTRY_GLES nulldrv_glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    nulldrv_record(NULLDRV_glGetActiveAttrib);
+    if(length) *length = 0;
+    if(size) *size = 0;
+    if(bufSize>0 && name) name[0] = '\0';
+}
+static void APIENTRY_GLES nulldrv_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    nulldrv_record(NULLDRV_glGetActiveUniform);
+    nulldrv_object_t *o = nulldrv_getobject(program);
+    if(!o || index>=o->nuniforms) {
+        if(length) *length = 0;
+        if(size) *size = 0;
+        if(bufSize>0 && name) name[0] = '\0';
+        return;
+    }
+    nulldrv_uniform_t *u = o->uniforms+index;
+    int n = 0;
+    if(bufSize>0 && name)
+        n = snprintf(name, bufSize, (u->size>1)?"%s[0]":"%s", u->name);
+    if(length) *length = (bufSize>0)?((n<bufSize)?n:(bufSize-1)):0;
+    if(size) *size = u->size;
+    if(type) *type = u->type;
+}
+static GLint APIENTRY_GLES nulldrv_glGetAttribLocation(GLuint program, const GLchar *name) {
+    nulldrv_record(NULLDRV_glGetAttribLocation);
+    return -1;
+}
+static GLint APIENTRY_GLES nulldrv_glGetUniformLocation(GLuint program, const GLchar *name) {
+    nulldrv_record(NULLDRV_glGetUniformLocation);
+    nulldrv_object_t *o = nulldrv_getobject(program);
+    if(!o)
+        return -1;
+    // "name" or "name[i]"
+    const char *b = strchr(name, '[');
+    int len = b?(b-name):strlen(name);
+    int i = b?atoi(b+1):0;
+    for (int j=0; j<o->nuniforms; ++j) {
+        nulldrv_uniform_t *u = o->uniforms+j;
+        if(!strncmp(u->name, name, len) && u->name[len]=='\0')
+            return (i>=0 && i<u->size)?(u->location+i):-1;
+    }
+    return -1;
+}
+static void APIENTRY_GLES nulldrv_glGetShaderPrecisionFormat(GLenum shadertype, GLenum precisiontype, GLint *range, GLint *precision) {
+    nulldrv_record(NULLDRV_glGetShaderPrecisionFormat);
+    range[0] = range[1] = 127;
+    *precision = 23;
+}
+
+// Uploads
+static void APIENTRY_GLES nulldrv_glBufferData(GLenum target, GLsizeiptr size, const GLvoid *data, GLenum usage) {
+    nulldrv_record(NULLDRV_glBufferData);
+    if(data) nulldrv.stats.buffer_bytes += size;
+}
+static void APIENTRY_GLES nulldrv_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid *data) {
+    nulldrv_record(NULLDRV_glBufferSubData);
+    nulldrv.stats.buffer_bytes += size;
+}
+static void APIENTRY_GLES nulldrv_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *data) {
+    nulldrv_record(NULLDRV_glTexImage2D);
+    if(data) nulldrv.stats.texture_bytes += (unsigned long long)width*height*pixel_sizeof(format, type);
+}
+static void APIENTRY_GLES nulldrv_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *data) {
+    nulldrv_record(NULLDRV_glTexSubImage2D);
+    if(data) nulldrv.stats.texture_bytes += (unsigned long long)width*height*pixel_sizeof(format, type);
+}
+static void APIENTRY_GLES nulldrv_glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid *data) {
+    nulldrv_record(NULLDRV_glCompressedTexImage2D);
+    if(data) nulldrv.stats.texture_bytes += imageSize;
+}
+static void APIENTRY_GLES nulldrv_glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid *data) {
+    nulldrv_record(NULLDRV_glCompressedTexSubImage2D);
+    if(data) nulldrv.stats.texture_bytes += imageSize;
+}
+static void APIENTRY_GLES nulldrv_glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *pixels) {
+    nulldrv_record(NULLDRV_glReadPixels);
+    if(pixels) memset(pixels, 0, (size_t)width*height*pixel_sizeof(format, type));
+}
+
+// Draws
+static void APIENTRY_GLES nulldrv_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    nulldrv_record(NULLDRV_glDrawArrays);
+    ++nulldrv.stats.draws;
+    nulldrv.stats.vertices += count;
+}
+static void APIENTRY_GLES nulldrv_glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices) {
+    nulldrv_record(NULLDRV_glDrawElements);
+    ++nulldrv.stats.draws;
+    nulldrv.stats.vertices += count;
+}
+static void APIENTRY_GLES nulldrv_glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex) {
+    nulldrv_record(NULLDRV_glDrawElementsBaseVertex);
+    ++nulldrv.stats.draws;
+    nulldrv.stats.vertices += count;
+}
+static void APIENTRY_GLES nulldrv_glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) {
+    nulldrv_record(NULLDRV_glDrawArraysInstanced);
+    ++nulldrv.stats.draws;
+    nulldrv.stats.vertices += (unsigned long long)count*instancecount;
+}
+static void APIENTRY_GLES nulldrv_glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount) {
+    nulldrv_record(NULLDRV_glDrawElementsInstanced);
+    ++nulldrv.stats.draws;
+    nulldrv.stats.vertices += (unsigned long long)count*instancecount;
+}
+static void APIENTRY_GLES nulldrv_glMultiDrawArrays(GLenum mode, const GLint *first, const GLsizei *count, GLsizei primcount) {
+    nulldrv_record(NULLDRV_glMultiDrawArrays);
+    nulldrv.stats.draws += primcount;
+    for (int i=0; i<primcount; ++i)
+        nulldrv.stats.vertices += count[i];
+}
+static void APIENTRY_GLES nulldrv_glMultiDrawElements(GLenum mode, GLsizei *count, GLenum type, const void * const *indices, GLsizei primcount) {
+    nulldrv_record(NULLDRV_glMultiDrawElements);
+    nulldrv.stats.draws += primcount;
+    for (int i=0; i<primcount; ++i)
+        nulldrv.stats.vertices += count[i];
+}
+static void APIENTRY_GLES nulldrv_glDrawTexf(GLfloat x, GLfloat y, GLfloat z, GLfloat width, GLfloat height) {
+    nulldrv_record(NULLDRV_glDrawTexf);
+    ++nulldrv.stats.draws;
+    nulldrv.stats.vertices += 4;
+}
+static void APIENTRY_GLES nulldrv_glDrawTexi(GLint x, GLint y, GLint z, GLint width, GLint height) {
+    nulldrv_record(NULLDRV_glDrawTexi);
+    ++nulldrv.stats.draws;
+    nulldrv.stats.vertices += 4;
+}
+
+static void* const nulldrv_procs[NULLDRV_FRAME] = {
+#define _NOOP(name) (void*)nulldrv_##name,
+#define _IMPL(name) (void*)nulldrv_##name,
+#include "nulldrvfuncs.inc"
+#undef _NOOP
+#undef _IMPL
+};
+
+#ifndef NOEGL
+// Minimal EGL: enough for the loader, the glX / EGL layers (so a real application or a trace
+// replayer can run on the null driver) and to count frames. Everything is a fake handle.
+#define NULLDRV_HANDLE(n)   ((void*)(&nulldrv.names+(n)))
+static EGLDisplay nulldrv_eglGetDisplay(EGLNativeDisplayType display_id) {
+    return (EGLDisplay)NULLDRV_HANDLE(0);
+}
+static EGLDisplay nulldrv_eglGetPlatformDisplay(EGLenum platform, void *native_display, const intptr_t *attrib_list) {
+    return (EGLDisplay)NULLDRV_HANDLE(0);
+}
+static EGLBoolean nulldrv_eglInitialize(EGLDisplay dpy, EGLint *major, EGLint *minor) {
+    if(major) *major = 1;
+    if(minor) *minor = 4;
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglTerminate(EGLDisplay dpy) {
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglGetConfigs(EGLDisplay dpy, EGLConfig *configs, EGLint config_size, EGLint *num_config) {
+    // a single config, that can do everything
+    if(configs && config_size>0)
+        configs[0] = (EGLConfig)NULLDRV_HANDLE(1);
+    if(num_config)
+        *num_config = 1;
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglChooseConfig(EGLDisplay dpy, const EGLint *attrib_list, EGLConfig *configs, EGLint config_size, EGLint *num_config) {
+    return nulldrv_eglGetConfigs(dpy, configs, config_size, num_config);
+}
+static EGLBoolean nulldrv_eglGetConfigAttrib(EGLDisplay dpy, EGLConfig config, EGLint attribute, EGLint *value) {
+    switch(attribute) {
+        case EGL_RED_SIZE:
+        case EGL_GREEN_SIZE:
+        case EGL_BLUE_SIZE:
+        case EGL_ALPHA_SIZE:
+        case EGL_STENCIL_SIZE:
+            *value = 8; break;
+        case EGL_DEPTH_SIZE:
+            *value = 24; break;
+        case EGL_BUFFER_SIZE:
+            *value = 32; break;
+        case EGL_CONFIG_ID:
+            *value = 1; break;
+        case EGL_SURFACE_TYPE:
+            *value = EGL_WINDOW_BIT|EGL_PBUFFER_BIT|EGL_PIXMAP_BIT; break;
+        case EGL_RENDERABLE_TYPE:
+        case EGL_CONFORMANT:
+            *value = EGL_OPENGL_ES_BIT|EGL_OPENGL_ES2_BIT|0x0040/*EGL_OPENGL_ES3_BIT*/; break;
+        case EGL_MAX_PBUFFER_WIDTH:
+        case EGL_MAX_PBUFFER_HEIGHT:
+            *value = 4096; break;
+        default:
+            *value = 0;
+    }
+    return EGL_TRUE;
+}
+static EGLSurface nulldrv_eglCreateWindowSurface(EGLDisplay dpy, EGLConfig config, EGLNativeWindowType win, const EGLint *attrib_list) {
+    return (EGLSurface)NULLDRV_HANDLE(2);
+}
+static EGLSurface nulldrv_eglCreatePlatformWindowSurface(EGLDisplay dpy, EGLConfig config, void *native_window, const intptr_t *attrib_list) {
+    return (EGLSurface)NULLDRV_HANDLE(2);
+}
+static EGLSurface nulldrv_eglCreatePbufferSurface(EGLDisplay dpy, EGLConfig config, const EGLint *attrib_list) {
+    return (EGLSurface)NULLDRV_HANDLE(2);
+}
+static EGLSurface nulldrv_eglCreatePixmapSurface(EGLDisplay dpy, EGLConfig config, EGLNativePixmapType pixmap, const EGLint *attrib_list) {
+    return (EGLSurface)NULLDRV_HANDLE(2);
+}
+static EGLSurface nulldrv_eglCreatePbufferFromClientBuffer(EGLDisplay dpy, EGLenum buftype, EGLClientBuffer buffer, EGLConfig config, const EGLint *attrib_list) {
+    return (EGLSurface)NULLDRV_HANDLE(2);
+}
+static EGLBoolean nulldrv_eglDestroySurface(EGLDisplay dpy, EGLSurface surface) {
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglQuerySurface(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint *value) {
+    switch(attribute) {
+        case EGL_WIDTH: *value = NULLDRV_WIDTH; break;
+        case EGL_HEIGHT: *value = NULLDRV_HEIGHT; break;
+        case EGL_CONFIG_ID: *value = 1; break;
+        default: *value = 0;
+    }
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglSurfaceAttrib(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint value) {
+    return EGL_TRUE;
+}
+static EGLContext nulldrv_eglCreateContext(EGLDisplay dpy, EGLConfig config, EGLContext share_context, const EGLint *attrib_list) {
+    return (EGLContext)NULLDRV_HANDLE(3);
+}
+static EGLBoolean nulldrv_eglDestroyContext(EGLDisplay dpy, EGLContext ctx) {
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglQueryContext(EGLDisplay dpy, EGLContext ctx, EGLint attribute, EGLint *value) {
+    *value = (attribute==EGL_CONFIG_ID)?1:0;
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglMakeCurrent(EGLDisplay dpy, EGLSurface draw, EGLSurface read, EGLContext ctx) {
+    return EGL_TRUE;
+}
+static EGLContext nulldrv_eglGetCurrentContext() {
+    return (EGLContext)NULLDRV_HANDLE(3);
+}
+static EGLSurface nulldrv_eglGetCurrentSurface(EGLint readdraw) {
+    return (EGLSurface)NULLDRV_HANDLE(2);
+}
+static EGLDisplay nulldrv_eglGetCurrentDisplay() {
+    return (EGLDisplay)NULLDRV_HANDLE(0);
+}
+static const char* nulldrv_eglQueryString(EGLDisplay dpy, EGLint name) {
+    switch(name) {
+        case EGL_VENDOR: return "gl4es";
+        case EGL_VERSION: return "1.4 null";
+        case EGL_CLIENT_APIS: return "OpenGL_ES";
+        default: return "";
+    }
+}
+static EGLBoolean nulldrv_eglBindAPI(EGLenum api) {
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglSwapInterval(EGLDisplay dpy, EGLint interval) {
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglWait(EGLint engine) {
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglWaitNoArg() {
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglCopyBuffers(EGLDisplay dpy, EGLSurface surface, EGLNativePixmapType target) {
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglTexImage(EGLDisplay dpy, EGLSurface surface, EGLint buffer) {
+    return EGL_TRUE;
+}
+static EGLBoolean nulldrv_eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
+    ++nulldrv.stats.frames;
+    nulldrv_record(NULLDRV_FRAME);
+    return EGL_TRUE;
+}
+static EGLint nulldrv_eglGetError() {
+    return EGL_SUCCESS;
+}
+static void* nulldrv_eglGetProcAddress(const char *procname) {
+    return nulldrv_GetProcAddress(procname);
+}
+
+static const struct {
+    const char  *name;
+    void        *proc;
+} nulldrv_eglprocs[] = {
+    {"eglGetDisplay", nulldrv_eglGetDisplay},
+    {"eglGetPlatformDisplay", nulldrv_eglGetPlatformDisplay},
+    {"eglInitialize", nulldrv_eglInitialize},
+    {"eglTerminate", nulldrv_eglTerminate},
+    {"eglGetConfigs", nulldrv_eglGetConfigs},
+    {"eglChooseConfig", nulldrv_eglChooseConfig},
+    {"eglGetConfigAttrib", nulldrv_eglGetConfigAttrib},
+    {"eglCreateWindowSurface", nulldrv_eglCreateWindowSurface},
+    {"eglCreatePlatformWindowSurface", nulldrv_eglCreatePlatformWindowSurface},
+    {"eglCreatePbufferSurface", nulldrv_eglCreatePbufferSurface},
+    {"eglCreatePixmapSurface", nulldrv_eglCreatePixmapSurface},
+    {"eglCreatePbufferFromClientBuffer", nulldrv_eglCreatePbufferFromClientBuffer},
+    {"eglDestroySurface", nulldrv_eglDestroySurface},
+    {"eglQuerySurface", nulldrv_eglQuerySurface},
+    {"eglSurfaceAttrib", nulldrv_eglSurfaceAttrib},
+    {"eglCreateContext", nulldrv_eglCreateContext},
+    {"eglDestroyContext", nulldrv_eglDestroyContext},
+    {"eglQueryContext", nulldrv_eglQueryContext},
+    {"eglMakeCurrent", nulldrv_eglMakeCurrent},
+    {"eglGetCurrentContext", nulldrv_eglGetCurrentContext},
+    {"eglGetCurrentSurface", nulldrv_eglGetCurrentSurface},
+    {"eglGetCurrentDisplay", nulldrv_eglGetCurrentDisplay},
+    {"eglQueryString", nulldrv_eglQueryString},
+    {"eglBindAPI", nulldrv_eglBindAPI},
+    {"eglSwapInterval", nulldrv_eglSwapInterval},
+    {"eglWaitNative", nulldrv_eglWait},
+    {"eglWaitGL", nulldrv_eglWaitNoArg},
+    {"eglWaitClient", nulldrv_eglWaitNoArg},
+    {"eglReleaseThread", nulldrv_eglWaitNoArg},
+    {"eglCopyBuffers", nulldrv_eglCopyBuffers},
+    {"eglBindTexImage", nulldrv_eglTexImage},
+    {"eglReleaseTexImage", nulldrv_eglTexImage},
+    {"eglSwapBuffers", nulldrv_eglSwapBuffers},
+    {"eglGetError", nulldrv_eglGetError},
+    {"eglGetProcAddress", nulldrv_eglGetProcAddress},
+};
+#undef NULLDRV_HANDLE
+#endif
+
+static int nulldrv_find(const char *name) {
+    // OES / EXT entry points are the same as the core ones
+    int len = strlen(name);
+    if(len>3 && (!strcmp(name+len-3, "OES") || !strcmp(name+len-3, "EXT")))
+        len -= 3;
+    for (int i=0; i<NULLDRV_FRAME; ++i)
+        if(!strncmp(nulldrv_names[i], name, len) && nulldrv_names[i][len]=='\0')
+            return i;
+    return -1;
+}
+
+void* nulldrv_GetProcAddress(const char *name) {
+#ifndef NOEGL
+    if(name[0]=='e') {
+        int len = strlen(name);
+        // KHR / EXT EGL extensions are the same as the core ones
+        if(len>3 && (!strcmp(name+len-3, "KHR") || !strcmp(name+len-3, "EXT")))
+            len -= 3;
+        for (int i=0; i<sizeof(nulldrv_eglprocs)/sizeof(nulldrv_eglprocs[0]); ++i)
+            if(!strncmp(nulldrv_eglprocs[i].name, name, len) && nulldrv_eglprocs[i].name[len]=='\0')
+                return nulldrv_eglprocs[i].proc;
+        DBG(SHUT_LOGD("nulldrv: no %s\n", name);)
+        return NULL;
+    }
+#endif
+    int i = nulldrv_find(name);
+    DBG(if(i<0) SHUT_LOGD("nulldrv: no %s\n", name);)
+    return (i<0)?NULL:nulldrv_procs[i];
+}
+
+void* nulldrv_init(int mode) {
+    nulldrv.mode = mode;
+    if(mode>1 && !nulldrv.log)
+        nulldrv.log = (unsigned short*)malloc(NULLDRV_LOG_SIZE*sizeof(unsigned short));
+    return &nulldrv;
+}
+
+void gl4es_nulldrv_getstats(gl4es_nulldrv_stats_t *stats) {
+    memcpy(stats, &nulldrv.stats, sizeof(gl4es_nulldrv_stats_t));
+}
+
+unsigned long long gl4es_nulldrv_getcallcount(const char *name) {
+    int i = nulldrv_find(name);
+    return (i<0)?0:nulldrv.calls[i];
+}
+
+void gl4es_nulldrv_reset(void) {
+    memset(&nulldrv.stats, 0, sizeof(nulldrv.stats));
+    memset(nulldrv.calls, 0, sizeof(nulldrv.calls));
+    nulldrv.log_pos = 0;
+}
+
+int gl4es_nulldrv_dumplog(const char *filename) {
+    if(!nulldrv.log)
+        return -1;
+    FILE *f = fopen(filename, "w");
+    if(!f)
+        return -1;
+    unsigned int first = (nulldrv.log_pos>NULLDRV_LOG_SIZE)?(nulldrv.log_pos-NULLDRV_LOG_SIZE):0;
+    for (unsigned int i=first; i<nulldrv.log_pos; ++i)
+        fprintf(f, "%s\n", nulldrv_names[nulldrv.log[i&(NULLDRV_LOG_SIZE-1)]]);
+    fclose(f);
+    return nulldrv.log_pos-first;
+}
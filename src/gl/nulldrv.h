@@ -0,0 +1,16 @@
+#ifndef _GL4ES_NULLDRV_H_
+#define _GL4ES_NULLDRV_H_
+
+#include <gl4esnulldrv.h>
+#include "attributes.h"
+
+// mode is 1 for counters only, 2 for counters + call log. Return the handle to use for gles & egl
+void* nulldrv_init(int mode);
+void* nulldrv_GetProcAddress(const char *name);
+
+EXPORT void gl4es_nulldrv_getstats(gl4es_nulldrv_stats_t *stats);
+EXPORT unsigned long long gl4es_nulldrv_getcallcount(const char *name);
+EXPORT void gl4es_nulldrv_reset(void);
+EXPORT int gl4es_nulldrv_dumplog(const char *filename);
+
+#endif // _GL4ES_NULLDRV_H_
@@ -326,12 +326,14 @@ void APIENTRY_GL4ES gl4es_glProgramEnvParameter4dARB(GLenum target, GLuint index
         case GL_VERTEX_PROGRAM_ARB:
             if(index<MAX_VTX_PROG_ENV_PARAMS) {
                 noerrorShimNoPurge();
+                DIRTY_UNIFORMS(UG_PROGPARAMS);
                 f = glstate->glsl->vtx_env_params+index*4;
             }
             break;
         case GL_FRAGMENT_PROGRAM_ARB:
             if(index<MAX_FRG_PROG_ENV_PARAMS) {
                 noerrorShimNoPurge();
+                DIRTY_UNIFORMS(UG_PROGPARAMS);
                 f = glstate->glsl->frg_env_params+index*4;
             } else
                 errorShim(GL_INVALID_VALUE);
@@ -355,12 +357,14 @@ void APIENTRY_GL4ES gl4es_glProgramEnvParameter4dvARB(GLenum target, GLuint inde
         case GL_VERTEX_PROGRAM_ARB:
             if(index<MAX_VTX_PROG_ENV_PARAMS) {
                 noerrorShimNoPurge();
+                DIRTY_UNIFORMS(UG_PROGPARAMS);
                 f = glstate->glsl->vtx_env_params+index*4;
             }
             break;
         case GL_FRAGMENT_PROGRAM_ARB:
             if(index<MAX_FRG_PROG_ENV_PARAMS) {
                 noerrorShimNoPurge();
+                DIRTY_UNIFORMS(UG_PROGPARAMS);
                 f = glstate->glsl->frg_env_params+index*4;
             }
             break;
@@ -383,12 +387,14 @@ void APIENTRY_GL4ES gl4es_glProgramEnvParameter4fARB(GLenum target, GLuint index
         case GL_VERTEX_PROGRAM_ARB:
             if(index<MAX_VTX_PROG_ENV_PARAMS) {
                 noerrorShimNoPurge();
+                DIRTY_UNIFORMS(UG_PROGPARAMS);
                 f = glstate->glsl->vtx_env_params+index*4;
             }
             break;
         case GL_FRAGMENT_PROGRAM_ARB:
             if(index<MAX_FRG_PROG_ENV_PARAMS) {
                 noerrorShimNoPurge();
+                DIRTY_UNIFORMS(UG_PROGPARAMS);
                 f = glstate->glsl->frg_env_params+index*4;
             }
             break;
@@ -422,6 +428,7 @@ void APIENTRY_GL4ES gl4es_glProgramEnvParameter4fvARB(GLenum target, GLuint inde
     }
     if(f) {
         noerrorShimNoPurge();
+        DIRTY_UNIFORMS(UG_PROGPARAMS);
         memcpy(f, params, 4*sizeof(float));
     } else
         errorShim(GL_INVALID_VALUE);
@@ -447,6 +454,7 @@ void APIENTRY_GL4ES gl4es_glProgramLocalParameter4dARB(GLenum target, GLuint ind
     }
     if(index<old->max_local_params) {
         noerrorShimNoPurge();
+        DIRTY_UNIFORMS(UG_PROGPARAMS);
         float* f = old->prog_local_params+index*4;
         f[0] = x;
         f[1] = y;
@@ -475,6 +483,7 @@ void APIENTRY_GL4ES gl4es_glProgramLocalParameter4dvARB(GLenum target, GLuint in
     }
     if(index<old->max_local_params) {
         noerrorShimNoPurge();
+        DIRTY_UNIFORMS(UG_PROGPARAMS);
         float* f = old->prog_local_params+index*4;
         f[0] = params[0];
         f[1] = params[1];
@@ -503,6 +512,7 @@ void APIENTRY_GL4ES gl4es_glProgramLocalParameter4fARB(GLenum target, GLuint ind
     }
     if(index<old->max_local_params) {
         noerrorShimNoPurge();
+        DIRTY_UNIFORMS(UG_PROGPARAMS);
         float* f = old->prog_local_params+index*4;
         f[0] = x;
         f[1] = y;
@@ -531,6 +541,7 @@ void APIENTRY_GL4ES gl4es_glProgramLocalParameter4fvARB(GLenum target, GLuint in
     }
     if(index<old->max_local_params) {
         noerrorShimNoPurge();
+        DIRTY_UNIFORMS(UG_PROGPARAMS);
         memcpy(old->prog_local_params+index*4, params, 4*sizeof(float));
     } else
         errorShim(GL_INVALID_VALUE);
@@ -803,6 +814,7 @@ void APIENTRY_GL4ES gl4es_glProgramEnvParameters4fvEXT(GLenum target, GLuint ind
     }
     if(f && index+count<=nmax && count>=0) {
         noerrorShimNoPurge();
+        DIRTY_UNIFORMS(UG_PROGPARAMS);
         memcpy(f, params, count*4*sizeof(float));
     } else
         errorShim(GL_INVALID_VALUE);
@@ -830,6 +842,7 @@ void APIENTRY_GL4ES gl4es_glProgramLocalParameters4fvEXT(GLenum target, GLuint i
     }
     if(index+count<old->max_local_params && count>=0) {
         noerrorShimNoPurge();
+        DIRTY_UNIFORMS(UG_PROGPARAMS);
         memcpy(old->prog_local_params+index*4, params, count*4*sizeof(float));
     } else
         errorShim(GL_INVALID_VALUE);
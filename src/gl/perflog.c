@@ -0,0 +1,71 @@
+#include "perflog.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "init.h"
+#include "logs.h"
+#include "nulldrv.h"
+
+typedef struct {
+    FILE                    *f;
+    unsigned int            frame;
+    unsigned long long      cpu;        // thread CPU time at last frame (ns)
+    unsigned long long      wall;       // monotonic time at last frame (ns)
+    gl4es_nulldrv_stats_t   stats;      // null driver counters at last frame
+} perflog_t;
+
+static perflog_t perflog = {0};
+
+static unsigned long long perflog_time(int cpu) {
+#ifdef _WIN32
+    return (unsigned long long)clock()*(1000000000ULL/CLOCKS_PER_SEC);
+#else
+    struct timespec ts;
+    clock_gettime(cpu?CLOCK_THREAD_CPUTIME_ID:CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec*1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+static int perflog_open() {
+    perflog.f = fopen(globals4es.perflog, "w");
+    if(!perflog.f) {
+        SHUT_LOGE("Cannot open perf log \"%s\", disabling it\n", globals4es.perflog);
+        globals4es.perflog = NULL;
+        return 0;
+    }
+    fprintf(perflog.f, "# frame cpu_us wall_us gles_calls draws vertices buffer_bytes texture_bytes\n");
+    return 1;
+}
+
+void perflog_frame() {
+    if(!globals4es.perflog)
+        return;
+    unsigned long long cpu = perflog_time(1);
+    unsigned long long wall = perflog_time(0);
+    gl4es_nulldrv_stats_t stats;
+    gl4es_nulldrv_getstats(&stats);
+    if(!perflog.f) {
+        // first frame only start the measure: the time before it is loading, not rendering
+        if(!perflog_open())
+            return;
+    } else {
+        fprintf(perflog.f, "%u %llu %llu %llu %llu %llu %llu %llu\n", perflog.frame,
+            (cpu-perflog.cpu)/1000, (wall-perflog.wall)/1000,
+            stats.calls-perflog.stats.calls, stats.draws-perflog.stats.draws,
+            stats.vertices-perflog.stats.vertices, stats.buffer_bytes-perflog.stats.buffer_bytes,
+            stats.texture_bytes-perflog.stats.texture_bytes);
+    }
+    ++perflog.frame;
+    perflog.cpu = cpu;
+    perflog.wall = wall;
+    memcpy(&perflog.stats, &stats, sizeof(stats));
+}
+
+void perflog_close() {
+    if(perflog.f) {
+        fclose(perflog.f);
+        perflog.f = NULL;
+    }
+}
@@ -0,0 +1,12 @@
+#ifndef _GL4ES_PERFLOG_H_
+#define _GL4ES_PERFLOG_H_
+
+// Per-frame performance log, enabled with LIBGL_PERFLOG=filename
+// One line per frame: CPU time of the rendering thread, wall time, and (on the null driver) GLES calls / draws / uploaded bytes
+
+// called once per frame, just after the eglSwapBuffers
+void perflog_frame();
+// flush and close the log
+void perflog_close();
+
+#endif // _GL4ES_PERFLOG_H_
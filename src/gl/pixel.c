@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include "counters.h"
 #include "enum_info.h"
 #include "gl4es.h"
 #include "glstate.h"
@@ -790,6 +791,9 @@ bool pixel_convert(const GLvoid *src, GLvoid **dst,
     if (src_type == GL_HALF_FLOAT) src_type = GL_HALF_FLOAT_OES;
     if (dst_type == GL_HALF_FLOAT) dst_type = GL_HALF_FLOAT_OES;
 
+    COUNTER_INC(pixel_converts);
+    COUNTER_ADD(pixel_convert_bytes, dst_size);
+
     // Check for format and type compatibility
     if ((src_type == dst_type) && (dst_format == src_format)) {
         if (*dst == src) return true;
@@ -26,6 +26,7 @@ void APIENTRY_GL4ES gl4es_glClipPlanef(GLenum plane, const GLfloat *equation)
     } else {    // TODO: should first compute the clipplane and compare to stored one before sending to hardware
         int p = plane-GL_CLIP_PLANE0;
         matrix_vector(getInvMVMat(), equation, glstate->planes[p]); //Tested, seems ok
+        DIRTY_UNIFORMS(UG_CLIPPLANES);
         noerrorShim();
     }
 }
@@ -108,6 +108,7 @@ void APIENTRY_GL4ES gl4es_glPointParameterfv(GLenum pname, const GLfloat * param
             break;
     }
 
+    DIRTY_UNIFORMS(UG_POINTSPRITE);
     LOAD_GLES_FPE(glPointParameterfv);
     errorGL();
     gles_glPointParameterfv(pname, params);
@@ -122,6 +123,7 @@ void APIENTRY_GL4ES gl4es_glPointSize(GLfloat size) {
         return;
     }
     glstate->pointsprite.size = size;
+    DIRTY_UNIFORMS(UG_POINTSPRITE);
     errorGL();
     LOAD_GLES_FPE(glPointSize);
     gles_glPointSize(size);
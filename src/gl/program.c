@@ -5,6 +5,7 @@
 #include <GL/gl.h>
 #include <regex.h>
 #include "../glx/hardext.h"
+#include "counters.h"
 #include "debug.h"
 #include "fpe.h"
 #include "gl4es.h"
@@ -12,7 +13,9 @@
 #include "loader.h"
 #include "shaderconv.h"
 #include "fpe_shader.h"
+#include "fpe_ubo.h"
 #include "string_utils.h"
+#include "tracer.h"
 
 //#define DEBUG
 #ifdef DEBUG
@@ -314,6 +317,8 @@ void deleteProgram(program_t *glprogram, khint_t k_program) {
         kh_destroy(uniformlist, glprogram->uniform);
         glprogram->uniform = NULL;
     }
+    free(glprogram->uniform_loc);
+    free(glprogram->parent_sync);
     // clean cache
     if(glprogram->cache.cache)
         free(glprogram->cache.cache);
@@ -678,6 +683,14 @@ static void clear_program(program_t *glprogram)
             kh_del(uniformlist, glprogram->uniform, k);
         )
     }
+    free(glprogram->uniform_loc);
+    glprogram->uniform_loc = NULL;
+    glprogram->uniform_loc_size = 0;
+    free(glprogram->parent_sync);
+    glprogram->parent_sync = NULL;
+    glprogram->parent_sync_size = 0;
+    glprogram->parent_link = 0;
+    ++glprogram->link_gen;  // custom programs will rebuild their sync list
     glprogram->cache.size = 0;  // reset cache buffer
 }
 
@@ -760,6 +773,8 @@ static void fill_program(program_t *glprogram)
         DBG(else SHUT_LOGD("LIBGL: Warning, getting Uniform #%d info failed with %s\n", i, PrintEnum(e2)))
     }
     free(name);
+    uniform_resolve(glprogram);
+    fpe_ubo_program(glprogram);
     // reset uniform cache
     if(glprogram->cache.cap < uniform_cache) {
         glprogram->cache.cap=uniform_cache;
@@ -777,6 +792,7 @@ static void fill_program(program_t *glprogram)
     }
 
     // Grab all Attrib
+    glprogram->va_used = 0;
     gles_glGetProgramiv(glprogram->id, GL_ACTIVE_ATTRIBUTES, &n);
     gles_glGetProgramiv(glprogram->id, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxsize);
     name = (char*)malloc(maxsize);
@@ -806,6 +822,7 @@ static void fill_program(program_t *glprogram)
                 glattribloc->real_index = i;
                 int builtin = builtin_CheckVertexAttrib(glprogram, name, id);
                 glprogram->va_size[id] = n_uniform(type); // same as uniform
+                glprogram->va_used |= 1<<id;
                 DBG(SHUT_LOGD(" attrib #%d : \"%s\"%s type=%s size=%d\n", id, glattribloc->name, builtin?" (builtin) ":"", PrintEnum(glattribloc->type), glattribloc->size))
             }
         }
@@ -982,6 +999,8 @@ void APIENTRY_GL4ES gl4es_glLinkProgram(GLuint program) {
     if (gles_glLinkProgram) {
         LOAD_GLES(glGetError);
         LOAD_GLES2(glGetProgramiv);
+        unsigned long long t0 = counters_now();
+        TRACE_BEGIN(trace_t0);
         gles_glLinkProgram(glprogram->id);
         GLenum err = gles_glGetError();
         // Get Link Status
@@ -991,8 +1010,11 @@ void APIENTRY_GL4ES gl4es_glLinkProgram(GLuint program) {
             set_uniforms_default_value(program, glprogram->declarations,
                                        MAX_UNIFORM_VARIABLE_NUMBER);
             fill_program(glprogram);
+            TRACE_END(trace_t0, "glLinkProgram", 0);
+            COUNTER_TIME(program_links, program_link_ns, t0);
             noerrorShimNoPurge();
         } else {
+            COUNTER_TIME(program_links, program_link_ns, t0);
             GLsizei log_length;
             gles_glGetProgramiv(glprogram->id, GL_INFO_LOG_LENGTH, &log_length);
             DBG(SHUT_LOGD("Linker error length: %i\n", log_length));
@@ -106,6 +106,29 @@ typedef enum {
     MAT_MAX
 } reserved_matrix_t;
 
+// groups of builtin uniforms, each one with a generation in glstate->uniform_gen
+typedef enum {
+    UG_MODELVIEW = 0,   // modelview based matrices, normal matrix and normal scale
+    UG_PROJECTION,
+    UG_TEXMATRIX,
+    UG_LIGHT,           // light sources and light model
+    UG_MATERIAL,
+    UG_FOG,
+    UG_CLIPPLANES,
+    UG_POINTSPRITE,
+    UG_TEXENV,
+    UG_TEXGEN,
+    UG_PROGPARAMS,      // ARB program env and local parameters
+    UG_MAX
+} uniform_group_t;
+
+typedef enum {
+    UNIFORM_OTHER = 0,
+    UNIFORM_FLOAT,  // float and vec, sent with glUniform{n}fv
+    UNIFORM_INT,    // int, ivec, bool and samplers, sent with glUniform{n}iv
+    UNIFORM_MATRIX, // sent with glUniformMatrix{n}fv
+} uniform_kind_t;
+
 typedef struct {
     GLuint          internal_id; // internal id of the uniform
     GLuint          id;     // glsl id of the uniform
@@ -117,6 +140,15 @@ typedef struct {
     int             cache_size; // this is GLsizeof(type)*size
     uintptr_t       parent_offs;    // in case the uniform is from a fpe custom program
     int             parent_size;    // 0 means not found in parent... like for builtin
+    unsigned int    gen;            // uniform_gen of the program when the value last changed
+    // pre-resolved at link time for the Go functions
+    uniform_kind_t  kind;
+    int             n;      // number of components, or of rows for a matrix
+    union {
+        void (APIENTRY_GLES *fv)(GLint location, GLsizei count, const GLfloat *value);
+        void (APIENTRY_GLES *iv)(GLint location, GLsizei count, const GLint *value);
+        void (APIENTRY_GLES *matrixfv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+    } upload;               // the GLES function matching kind and n (NULL if not available)
 } uniform_t;
 
 KHASH_MAP_DECLARE_INT(uniformlist, uniform_t *);
@@ -127,6 +159,12 @@ typedef struct {
     int             size;   // next available free space in the cache
 } uniformcache_t;
 
+// a uniform of an fpe custom program, and the one of the parent program it's copied from
+typedef struct {
+    uniform_t       *uniform;
+    uniform_t       *parent;
+} uniform_sync_t;
+
 typedef struct {
     int         has;
     GLint       ambient; //vec4
@@ -223,8 +261,11 @@ typedef struct {
     int             default_fragment;
     shaderconv_need_t *default_need;    // filled only if default_vertex or default_fragment is used
     int             va_size[MAX_VATTRIB];
+    GLuint          va_used;    // 1 bit per attribute with a va_size
     khash_t(attribloclist)     *attribloc;
     khash_t(uniformlist) *uniform;
+    uniform_t       **uniform_loc;  // the same uniforms, indexed by location (NULL if locations are too sparse)
+    int             uniform_loc_size;
     int             num_uniform;
     uniformcache_t  cache;
     // builtin attrib
@@ -250,6 +291,9 @@ typedef struct {
     int                             has_builtin_texgen;
     builtin_fog_t                   builtin_fog;
     GLint                           builtin_instanceID;
+    GLint                           builtin_instanceBase;
+    unsigned int                    builtin_gen[UG_MAX];    // generation of each group last sent
+    int                             has_fpe_ubo;            // builtins are in the FPE uniform block (see fpe_ubo.h)
     // fpe uniform
     GLint                           fpe_alpharef;
     int                             has_fpe;
@@ -281,6 +325,13 @@ typedef struct {
     GLint                           samplersCube[MAX_TEX];
     // that will be an fpe_cache_t*
     void*                           fpe_cache;
+    unsigned int                    uniform_gen;        // bumped each time a uniform value changes
+    unsigned int                    link_gen;           // bumped each time the program is (re)linked
+    // fpe custom programs: the uniforms synchronized with the parent program (see fpe_SyncUniforms)
+    uniform_sync_t*                 parent_sync;
+    int                             parent_sync_size;
+    unsigned int                    parent_link;        // link_gen of the parent when parent_sync was built
+    unsigned int                    parent_gen;         // uniform_gen of the parent at last synchronization
 	
     uniforms_declarations           declarations;
     int                             frag_data_changed;
@@ -337,6 +388,8 @@ int gl4es_getProgramBinary(GLuint program, int *length, GLenum *format, void** b
             gles_glUseProgram(prg);         \
     }
 
+// resolve kind and upload function of all the uniforms of the program and build its location table
+void uniform_resolve(program_t *glprogram);
 void GoUniformfv(program_t *glprogram, GLint location, int size, int count, const GLfloat *value);
 void GoUniformiv(program_t *glprogram, GLint location, int size, int count, const GLint *value);
 void GoUniformMatrix2fv(program_t *glprogram, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
@@ -345,10 +345,7 @@ void select_glDrawElements(const vertexattrib_t* vtx, GLenum mode, GLuint count,
 	GLuint *iind = (GLuint*)((type==GL_UNSIGNED_INT)?indices:NULL);
 
 	GLsizei min, max;
-	if(sind)
-		getminmax_indices_us(sind, &max, &min, count);
-	else
-		getminmax_indices_ui(iind, &max, &min, count);
+	minmax_indices(type, indices, count, &max, &min);
     max++;
 	GLfloat *vert = copy_gl_array(vtx->pointer, vtx->type, 
 			vtx->size, vtx->stride,
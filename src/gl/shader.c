@@ -1,12 +1,14 @@
 #include "shader.h"
 
 #include "../glx/hardext.h"
+#include "counters.h"
 #include "debug.h"
 #include "init.h"
 #include "gl4es.h"
 #include "glstate.h"
 #include "loader.h"
 #include "shaderconv.h"
+#include "tracer.h"
 #include "vgpu/shaderconv.h"
 #include "../glsl/glsl_for_es.h"
 
@@ -129,7 +131,11 @@ void APIENTRY_GL4ES gl4es_glCompileShader(GLuint shader) {
     glshader->compiled = 1;
     LOAD_GLES2(glCompileShader);
     if(gles_glCompileShader) {
+        unsigned long long t0 = counters_now();
+        TRACE_BEGIN(trace_t0);
         gles_glCompileShader(glshader->id);
+        TRACE_END(trace_t0, "glCompileShader", 0);
+        COUNTER_TIME(shader_compiles, shader_compile_ns, t0);
         errorGL();
         //if(globals4es.logshader) {
 		{ // always log the error of shader
@@ -205,6 +211,7 @@ void APIENTRY_GL4ES gl4es_glShaderSource(GLuint shader, GLsizei count, const GLc
     }
     LOAD_GLES2(glShaderSource);
     if (gles_glShaderSource) {
+        unsigned long long t0 = counters_now();
         // adapt shader if needed (i.e. not an es2 context and shader is not #version 100)
 		if(is_direct_shader(glshader->source))
 			glshader->converted = strdup(glshader->source);
@@ -218,8 +225,12 @@ void APIENTRY_GL4ES gl4es_glShaderSource(GLuint shader, GLsizei count, const GLc
                 glshader->is_converted_essl_320 = 0;
             }
             else {
+                TRACE_BEGIN(trace_t0);
                 char* result = GLSLtoGLSLES(glshader->source, glshader->type, globals4es.esversion);
+                TRACE_END(trace_t0, "GLSLtoGLSLES", strlen(glshader->source));
                 glshader->converted = strdup(result!=NULL?process_uniform_declarations(result, glshader->uniforms_declarations, &glshader->uniforms_declarations_count):ConvertShaderConditionally(glshader));
+                if(glshader->type==GL_VERTEX_SHADER)
+                    glshader->converted = InstanceBaseShader(glshader->converted);
                 glshader->is_converted_essl_320 = 1;
             }
             DBG(SHUT_LOGD("\n[INFO] [Shader] Converted Shader source: \n%s", glshader->converted))
@@ -230,6 +241,7 @@ void APIENTRY_GL4ES gl4es_glShaderSource(GLuint shader, GLsizei count, const GLc
     	num_add_f(&glshader->converted);
 
 	shader_conv_(&glshader->source, &glshader->converted);
+        COUNTER_TIME(shader_converts, shader_convert_ns, t0);
 
 
 		// send source to GLES2 hardware if any
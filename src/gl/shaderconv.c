@@ -4,6 +4,7 @@
 #include "../glx/hardext.h"
 #include "debug.h"
 #include "fpe_shader.h"
+#include "fpe_ubo.h"
 #include "init.h"
 #include "preproc.h"
 #include "string_utils.h"
@@ -236,6 +237,9 @@ static const char* gl4es_instanceID =
 "#define GL_ARB_draw_instanced 1\n"
 "uniform int _gl4es_InstanceID;\n";
 
+static const char* gl4es_instanceBase =
+"uniform int _gl4es_InstanceBase;\n";
+
 static const char* gl4es_frontColorSource =
 "varying lowp vec4 _gl4es_FrontColor;\n";
 
@@ -431,6 +435,25 @@ static const char* gl4es_VertexAttrib = "_gl4es_VertexAttrib_";
 char gl_VA[MAX_VATTRIB][32] = {0};
 char gl4es_VA[MAX_VATTRIB][32] = {0};
 
+// GLSL ES 3.00+ source already converted: add the instance base to gl_InstanceID, like ConvertShader does
+char* InstanceBaseShader(char* pBuffer)
+{
+  if(!strstr(pBuffer, "gl_InstanceID"))
+    return pBuffer;
+  int tmpsize = strlen(pBuffer)+1;
+  // after the #version and #extension directives
+  int line = 1;
+  for (char* p = strstr(pBuffer, "#extension"); p; p = strstr(p+1, "#extension")) {
+    int n = 1;
+    for (char* q = pBuffer; q<p; q++)
+      if(*q=='\n') n++;
+    line = n;
+  }
+  pBuffer = InplaceInsert(GetLine(pBuffer, line), gl4es_instanceBase, pBuffer, &tmpsize);
+  pBuffer = InplaceReplace(pBuffer, &tmpsize, "gl_InstanceID", "(gl_InstanceID+_gl4es_InstanceBase)");
+  return pBuffer;
+}
+
 char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need, int forwardPort)
 {
   if(gl_VA[0][0]=='\0') {
@@ -440,6 +463,8 @@ char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need, i
     }
   }
   int fpeShader = (strstr(pEntry, fpeshader_signature)!=NULL)?1:0;
+  // FPE shaders with the builtins in the uniform block are GLSL ES 3.00, and the block already declares them
+  int fpeubo = (fpeShader && strstr(pEntry, FPE_UBO_NAME))?1:0;
   int maskbefore = 4|(isVertex?1:2);
   int maskafter = 8|(isVertex?1:2);
   if((globals4es.dbgshaderconv&maskbefore)==maskbefore) {
@@ -494,6 +519,8 @@ char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need, i
     else if(hardext.glsl300es) { versionHeader = 3; /* location on uniform not supported ! */ }
     /* else no location or in / out are supported */
   }
+  if(fpeubo)
+    versionHeader = 3;
   //sprintf(GLESFullHeader, GLESHeader, (wanthighp && hardext.highp==1 && !isVertex)?GLESUseFragHighp:"", (wanthighp)?"highp":"mediump", (wanthighp)?"highp":"mediump");
   sprintf(GLESFullHeader, GLESHeader[versionHeader], "", (wanthighp)?"highp":"mediump", (wanthighp)?"highp":"mediump");
 
@@ -883,6 +910,8 @@ char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need, i
               // ok, this matrix is used
               // replace gl_name by _gl4es_ one
               Tmp = InplaceReplace(Tmp, &tmpsize, builtin_matrix[i].glname, builtin_matrix[i].name);
+              if(fpeubo && (builtin_matrix[i].matrix==MAT_MV || builtin_matrix[i].matrix==MAT_MVP || builtin_matrix[i].matrix==MAT_N))
+                continue;   // member of the uniform block
               // insert a declaration of it
               char def[100];
               int ishighp = (isVertex || hardext.highp)?1:0;
@@ -955,13 +984,13 @@ char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need, i
     headline+=CountLine(gl4es_LightSourceParametersSource);
     Tmp = InplaceReplace(Tmp, &tmpsize, "gl_LightSourceParameters", "_gl4es_LightSourceParameters");
   }
-  if(strstr(Tmp, "gl_LightModelParameters") || strstr(Tmp, "gl_LightModel"))
+  if(!fpeubo && (strstr(Tmp, "gl_LightModelParameters") || strstr(Tmp, "gl_LightModel")))
   {
     Tmp = InplaceInsert(GetLine(Tmp, headline), gl4es_LightModelParametersSource, Tmp, &tmpsize);
     headline+=CountLine(gl4es_LightModelParametersSource);
     Tmp = InplaceReplace(Tmp, &tmpsize, "gl_LightModelParameters", "_gl4es_LightModelParameters");
   }
-  if(strstr(Tmp, "gl_LightModelProducts") || strstr(Tmp, "gl_FrontLightModelProduct") || strstr(Tmp, "gl_BackLightModelProduct"))
+  if(!fpeubo && (strstr(Tmp, "gl_LightModelProducts") || strstr(Tmp, "gl_FrontLightModelProduct") || strstr(Tmp, "gl_BackLightModelProduct")))
   {
     Tmp = InplaceInsert(GetLine(Tmp, headline), gl4es_LightModelProductsSource, Tmp, &tmpsize);
     headline+=CountLine(gl4es_LightModelProductsSource);
@@ -973,7 +1002,7 @@ char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need, i
     headline+=CountLine(gl4es_LightProductsSource);
     Tmp = InplaceReplace(Tmp, &tmpsize, "gl_LightProducts", "_gl4es_LightProducts");
   }
-  if(strstr(Tmp, "gl_MaterialParameters ") || (strstr(Tmp, "gl_FrontMaterial")) || strstr(Tmp, "gl_BackMaterial"))
+  if(!fpeubo && (strstr(Tmp, "gl_MaterialParameters ") || (strstr(Tmp, "gl_FrontMaterial")) || strstr(Tmp, "gl_BackMaterial")))
   {
     Tmp = InplaceInsert(GetLine(Tmp, headline), gl4es_MaterialParametersSource, Tmp, &tmpsize);
     headline+=CountLine(gl4es_MaterialParametersSource);
@@ -1003,11 +1032,22 @@ char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need, i
     Tmp = InplaceReplace(Tmp, &tmpsize, "gl_MaxLights", "_gl4es_MaxLights");
   }
   if(strstr(Tmp, "gl_NormalScale")) {
-    Tmp = InplaceInsert(GetLine(Tmp, headline), gl4es_normalscaleSource, Tmp, &tmpsize);
-    headline+=CountLine(gl4es_normalscaleSource);
+    if(!fpeubo) {
+      Tmp = InplaceInsert(GetLine(Tmp, headline), gl4es_normalscaleSource, Tmp, &tmpsize);
+      headline+=CountLine(gl4es_normalscaleSource);
+    }
     Tmp = InplaceReplace(Tmp, &tmpsize, "gl_NormalScale", "_gl4es_NormalScale");
   }
-  if(strstr(Tmp, "gl_InstanceID") || strstr(Tmp, "gl_InstanceIDARB")) {
+  if(versionHeader>1) {
+    // GLSL ES 3.00+ has a real gl_InstanceID, so instanced draws can be done in hardware
+    // the base is for the draws still done one instance at a time (gl_InstanceID is then 0)
+    if(strstr(Tmp, "gl_InstanceID") || strstr(Tmp, "gl_InstanceIDARB")) {
+      Tmp = InplaceInsert(GetLine(Tmp, headline), gl4es_instanceBase, Tmp, &tmpsize);
+      headline+=CountLine(gl4es_instanceBase);
+      Tmp = InplaceReplace(Tmp, &tmpsize, "gl_InstanceIDARB", "gl_InstanceID");
+      Tmp = InplaceReplace(Tmp, &tmpsize, "gl_InstanceID", "(gl_InstanceID+_gl4es_InstanceBase)");
+    }
+  } else if(strstr(Tmp, "gl_InstanceID") || strstr(Tmp, "gl_InstanceIDARB")) {
     Tmp = InplaceInsert(GetLine(Tmp, headline), gl4es_instanceID, Tmp, &tmpsize);
     headline+=CountLine(gl4es_instanceID);
     Tmp = InplaceReplace(Tmp, &tmpsize, "gl_InstanceIDARB", "_gl4es_InstanceID");
@@ -1032,7 +1072,7 @@ char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need, i
     }
   if(strstr(Tmp, "gl_Point"))
     Tmp = InplaceReplace(Tmp, &tmpsize, "gl_Point", "_gl4es_Point");
-  if(strstr(Tmp, "gl_FogParameters") || strstr(Tmp, "gl_Fog"))
+  if(!fpeubo && (strstr(Tmp, "gl_FogParameters") || strstr(Tmp, "gl_Fog")))
     {
       Tmp = InplaceInsert(GetLine(Tmp, headline), hardext.highp?gl4es_FogParametersSourceHighp:gl4es_FogParametersSource, Tmp, &tmpsize);
       headline+=CountLine(gl4es_FogParametersSource);
@@ -1223,7 +1263,18 @@ char* ConvertShader(const char* pEntry, int isVertex, shaderconv_need_t *need, i
     Tmp = InplaceReplace(Tmp, &tmpsize, "mat3x3", "mat3");
   }
 
-  if (versionHeader > 1) {
+  if (fpeubo) {
+    // the fragment stage needs its own backport (varying are inputs, and there is no gl_FragColor)
+    const char* GLESBackport = isVertex?"#define texture2D texture\n#define attribute in\n#define varying out\n"
+                                       :"#define texture2D texture\n#define texture2DProj textureProj\n#define textureCube texture\n#define varying in\n";
+    if(!isVertex && strstr(Tmp, "gl_FragColor")) {
+      Tmp = InplaceReplace(Tmp, &tmpsize, "gl_FragColor", "_gl4es_FragColor");
+      Tmp = InplaceInsert(GetLine(Tmp, headline), "out mediump vec4 _gl4es_FragColor;\n", Tmp, &tmpsize);
+      headline++;
+    }
+    if(!strstr(Tmp, GLESBackport))
+      Tmp = InplaceInsert(GetLine(Tmp, 1), GLESBackport, Tmp, &tmpsize);
+  } else if (versionHeader > 1) {
     const char* GLESBackport = "#define texture2D texture\n#define attribute in\n#define varying out\n";
     Tmp = InplaceInsert(GetLine(Tmp, 1), GLESBackport, Tmp, &tmpsize);
   }else {
@@ -6,6 +6,7 @@
 
 char * ConvertShaderConditionally(struct shader_s * shader_source);
 char* ConvertShader(const char* pBuffer, int isVertex, shaderconv_need_t *need, int forwardPort);
+char* InstanceBaseShader(char* pBuffer);
 
 int isBuiltinAttrib(const char* name);
 int isBuiltinMatrix(const char* name);
@@ -567,6 +567,7 @@ DBG(SHUT_LOGD("glPopAttrib()\n");)
             glstate->enable.texgen_t[a] = cur->texgen_t[a];
             glstate->enable.texgen_q[a] = cur->texgen_q[a];
             glstate->texgen[a] = cur->texgen[a];   // all mode and planes per texture in 1 line
+            DIRTY_UNIFORMS(UG_TEXGEN);
             for (int j=0; j<ENABLED_TEXTURE_LAST; j++)
                 if (cur->texture[a][j] != glstate->texture.bound[a][j]->texture) {
                     if(glstate->texture.active!=a)
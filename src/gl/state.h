@@ -210,6 +210,7 @@ typedef struct {
 typedef struct {
 	int		top;
     int     identity;
+    unsigned int gen;   // changes each time the top matrix changes, used to stamp the derived matrices
 	GLfloat	*stack;
 } matrixstack_t;
 
@@ -229,12 +230,51 @@ typedef struct glsl_s {
     oldprogram_t           *frg_prog;
 } glsl_t;
 
+// texture targets and buffer targets shadowed in gleshard_t
+enum {
+    HARD_TEX_2D = 0,
+    HARD_TEX_CUBE_MAP,
+    HARD_TEX_3D,
+    HARD_TEX_2D_ARRAY,
+    HARD_TEX_LAST
+};
+enum {
+    HARD_BUF_ARRAY = 0,
+    HARD_BUF_ELEMENT_ARRAY,
+    HARD_BUF_COPY_READ,
+    HARD_BUF_COPY_WRITE,
+    HARD_BUF_PIXEL_PACK,
+    HARD_BUF_PIXEL_UNPACK,
+    HARD_BUF_UNIFORM,
+    HARD_BUF_LAST
+};
+// value of a shadowed state not known yet (floats use NaN)
+#define HARD_UNKNOWN    0xffffffffu
+
 typedef struct {
     GLuint          program;
     program_t       *glprogram;
     GLuint          active; // active texture (is it shared?)
-    vertexattrib_t  vertexattrib[MAX_VATTRIB];
+    vertexattrib_t  *vertexattrib;  // attributes of the bound native vertex array (hardvao->vertexattrib)
+    hardvao_t       *hardvao;       // native vertex array bound on the driver
+    hardvao_t       defaultvao;     // the default native vertex array
     GLfloat         vavalue[MAX_VATTRIB][4];
+    // shadow of the rest of the driver state, see hardstate.c
+    GLuint          enabled;        // 1 bit per capability of hard_caps[] enabled on the driver
+    GLuint          enabled_known;  // capabilities bits with a known state
+    GLenum          blend_func[4];  // src rgb, dst rgb, src alpha, dst alpha
+    GLenum          blend_eq[2];    // rgb, alpha
+    GLfloat         blend_color[4];
+    GLenum          depth_func;
+    GLuint          depth_mask;
+    GLfloat         depth_range[2];
+    GLenum          cull_face;
+    GLenum          front_face;
+    GLint           viewport[4];
+    GLint           scissor[4];
+    GLuint          color_mask;     // 1 bit per channel
+    GLuint          texture[MAX_TEX][HARD_TEX_LAST];
+    GLuint          buffer[HARD_BUF_LAST];
 } gleshard_t;
 
 typedef struct {
@@ -0,0 +1,131 @@
+#include "stream.h"
+
+#include <string.h>
+
+#include "../glx/hardext.h"
+#include "counters.h"
+#include "enum_info.h"
+#include "gl4es.h"
+#include "glstate.h"
+#include "init.h"
+#include "loader.h"
+
+//#define DEBUG
+#ifdef DEBUG
+#define DBG(a) a
+#else
+#define DBG(a)
+#endif
+
+#define STREAM_ALIGN 16
+
+// arrays sharing the same memory (interleaved) are copied together
+typedef struct {
+    uintptr_t   base;   // lowest pointer of the arrays of the group
+    uintptr_t   end;    // end of the highest element of the group, for 1 vertex
+    int         stride;
+    int         size;   // bytes to copy
+    int         offset; // offset in the upload
+} stream_group_t;
+
+int stream_arrays(int imin, int imax) {
+    if(!globals4es.streamvbo || hardext.esversion==1 || imax<imin)
+        return 0;
+    stream_group_t groups[MAX_VATTRIB];
+    int group_of[MAX_VATTRIB];
+    int ngroups = 0;
+    for (int i=0; i<hardext.maxvattrib; i++) {
+        group_of[i] = -1;
+        vertexattrib_t *w = &glstate->vao->vertexattrib[i];
+        // arrays in a real VBO are already on the GPU, divisor arrays don't use the vertex range,
+        // and BGRA / GL_DOUBLE arrays are converted by realize_glenv
+        if(!w->enabled || w->real_buffer || w->divisor || w->size==GL_BGRA || w->type==GL_DOUBLE)
+            continue;
+        uintptr_t ptr = (uintptr_t)w->pointer + ((w->buffer)?(uintptr_t)w->buffer->data:0);
+        if(!ptr)
+            continue;
+        int elem = gl_sizeof(w->type)*w->size;
+        int stride = (w->stride)?w->stride:elem;
+        int g = 0;
+        while(g<ngroups && !(groups[g].stride==stride && ptr<groups[g].base+stride && ptr+stride>groups[g].base))
+            ++g;
+        if(g==ngroups) {
+            groups[g].base = ptr;
+            groups[g].end = ptr+elem;
+            groups[g].stride = stride;
+            ++ngroups;
+        } else {
+            if(ptr<groups[g].base) groups[g].base = ptr;
+            if(ptr+elem>groups[g].end) groups[g].end = ptr+elem;
+        }
+        group_of[i] = g;
+    }
+    if(!ngroups)
+        return 0;
+    // layout of the upload. The attributes offsets in the VBO are "offset-imin*stride", that cannot be negative
+    int total = 0;
+    int low = 0;
+    for (int g=0; g<ngroups; g++) {
+        groups[g].size = (imax-imin)*groups[g].stride + (groups[g].end-groups[g].base);
+        groups[g].offset = total;
+        total += (groups[g].size+STREAM_ALIGN-1)&~(STREAM_ALIGN-1);
+        if(imin*groups[g].stride>low)
+            low = imin*groups[g].stride;
+    }
+    low = (low+STREAM_ALIGN-1)&~(STREAM_ALIGN-1);
+    int ring = globals4es.streamvbo*1024*1024;
+    if(low+total>ring)
+        return 0;   // too big, the driver will deal with the client arrays
+    LOAD_GLES(glGenBuffers);
+    LOAD_GLES(glBufferData);
+    LOAD_GLES(glBufferSubData);
+    if(!glstate->stream_vbo) {
+        gles_glGenBuffers(1, &glstate->stream_vbo);
+        if(!glstate->stream_vbo)
+            return 0;
+        glstate->stream_pos = ring;  // force allocation
+    }
+    bindBuffer(GL_ARRAY_BUFFER, glstate->stream_vbo);
+    int pos = (glstate->stream_pos>low)?glstate->stream_pos:low;
+    if(pos+total>ring) {
+        // orphan the buffer: new storage for the next draws, the pending ones keep the old one
+        gles_glBufferData(GL_ARRAY_BUFFER, ring, NULL, GL_STREAM_DRAW);
+        COUNTER_INC(stream_orphans);
+        pos = low;
+    }
+    if(ngroups==1) {
+        gles_glBufferSubData(GL_ARRAY_BUFFER, pos, groups[0].size, (void*)(groups[0].base+imin*groups[0].stride));
+    } else {
+        if(glstate->stream_staging_size<total) {
+            free(glstate->stream_staging);
+            glstate->stream_staging = malloc(total);
+            glstate->stream_staging_size = total;
+        }
+        for (int g=0; g<ngroups; g++)
+            memcpy((char*)glstate->stream_staging+groups[g].offset, (void*)(groups[g].base+imin*groups[g].stride), groups[g].size);
+        gles_glBufferSubData(GL_ARRAY_BUFFER, pos, total, glstate->stream_staging);
+    }
+    COUNTER_INC(stream_uploads);
+    COUNTER_ADD(stream_bytes, total);
+    DBG(SHUT_LOGD("Streaming %d arrays groups, vertices %d..%d, %d bytes at %d\n", ngroups, imin, imax, total, pos);)
+    for (int i=0; i<hardext.maxvattrib; i++)
+        if(group_of[i]!=-1) {
+            vertexattrib_t *w = &glstate->vao->vertexattrib[i];
+            stream_group_t *g = &groups[group_of[i]];
+            uintptr_t ptr = (uintptr_t)w->pointer + ((w->buffer)?(uintptr_t)w->buffer->data:0);
+            w->real_buffer = glstate->stream_vbo;
+            w->real_pointer = (void*)(pos + g->offset - imin*g->stride + (ptr-g->base));
+            glstate->stream_mapped[i] = 1;
+        }
+    glstate->stream_pos = pos+total;
+    return 1;
+}
+
+void stream_done() {
+    for (int i=0; i<hardext.maxvattrib; i++)
+        if(glstate->stream_mapped[i]) {
+            glstate->vao->vertexattrib[i].real_buffer = 0;
+            glstate->vao->vertexattrib[i].real_pointer = NULL;
+            glstate->stream_mapped[i] = 0;
+        }
+}
@@ -0,0 +1,14 @@
+#ifndef _GL4ES_STREAM_H_
+#define _GL4ES_STREAM_H_
+
+// Streaming of client side vertex arrays in a ring VBO (see LIBGL_STREAMVBO)
+// The [imin, imax] vertex range of all the enabled client arrays is copied with one upload per draw,
+// and the attributes point inside the ring buffer until stream_done() (like ToBuffer does for locked arrays).
+// The ring is orphaned when full, so the driver never waits for the draws still using the previous content.
+
+// stream the client arrays for a draw using vertices imin..imax. Return 0 if nothing was streamed
+int stream_arrays(int imin, int imax);
+// put back the client pointers after the draw
+void stream_done();
+
+#endif // _GL4ES_STREAM_H_
@@ -74,6 +74,7 @@ void APIENTRY_GL4ES gl4es_glTexGenfv(GLenum coord, GLenum pname, const GLfloat *
             return;
         }
         case GL_OBJECT_PLANE:
+            DIRTY_UNIFORMS(UG_TEXGEN);
             switch (coord) {
                 case GL_S:
                     memcpy(glstate->texgen[glstate->texture.active].S_O, param, 4 * sizeof(GLfloat));
@@ -95,6 +96,7 @@ void APIENTRY_GL4ES gl4es_glTexGenfv(GLenum coord, GLenum pname, const GLfloat *
             // need to transform here
             GLfloat pe[4];
             vector_matrix(param, getInvMVMat(), pe);
+            DIRTY_UNIFORMS(UG_TEXGEN);
             switch (coord) {
                 case GL_S:
                     memcpy(glstate->texgen[glstate->texture.active].S_E, pe, 4 * sizeof(GLfloat));
@@ -251,12 +253,9 @@ void eye_loop(const GLfloat *verts, const GLfloat *param, GLfloat *out, GLint co
 void eye_loop_dual(const GLfloat *verts, const GLfloat *param1, const GLfloat* param2, GLfloat *out, GLint count, GLushort *indices) {
     // based on https://www.opengl.org/wiki/Mathematics_of_glTexGen
     // First get the ModelviewMatrix
-    GLfloat ModelviewMatrix[16], InvModelview[16];
-    gl4es_glGetFloatv(GL_MODELVIEW_MATRIX, InvModelview);
+    GLfloat ModelviewMatrix[16];
     // column major -> row major
-    matrix_transpose(InvModelview, ModelviewMatrix);
-    // And get the inverse
-    matrix_inverse(ModelviewMatrix, InvModelview);
+    matrix_transpose(getMVMat(), ModelviewMatrix);
     GLfloat tmp[4];
     for (int i=0; i<count; i++) {
 	GLushort k = indices?indices[i]:i;
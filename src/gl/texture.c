@@ -15,6 +15,7 @@
 #include "matrix.h"
 #include "pixel.h"
 #include "raster.h"
+#include "tracer.h"
 
 //#define DEBUG
 #ifdef DEBUG
@@ -1252,6 +1253,8 @@ void APIENTRY_GL4ES gl4es_glTexImage2D(GLenum target, GLint level, GLint interna
 
     if(((width>>shrink)==0) && ((height>>shrink)==0)) return;   // nothing to do
     if (datab) {
+        TRACE_BEGIN(trace_t0);
+        const GLsizei trace_size = width*height*pixel_sizeof(format, type);
 
         // implements GL_UNPACK_ROW_LENGTH
         if ((glstate->texture.unpack_row_length && glstate->texture.unpack_row_length != width)
@@ -1381,6 +1384,7 @@ void APIENTRY_GL4ES gl4es_glTexImage2D(GLenum target, GLint level, GLint interna
         if (globals4es.texdump) {
             pixel_to_ppm(pixels, width, height, format, type, bound->texture, glstate->texture.pack_align);
         }
+        TRACE_END(trace_t0, "glTexImage2D conversion", trace_size);
     } else {
 #ifdef TEXSTREAM
         if (globals4es.texstream && (target==GL_TEXTURE_2D || target==GL_TEXTURE_RECTANGLE_ARB) && (width>=256 && height>=224) &&
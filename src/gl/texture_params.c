@@ -758,10 +758,8 @@ void realize_bound(int TMU, GLenum target) {
 
 void realize_active() {
     LOAD_GLES(glActiveTexture);
-    if(glstate->gleshard->active == glstate->texture.active)
-        return;
-    glstate->gleshard->active = glstate->texture.active;
-    gles_glActiveTexture(GL_TEXTURE0 + glstate->gleshard->active);
+    // the driver state shadow drops it if already active
+    gles_glActiveTexture(GL_TEXTURE0 + glstate->texture.active);
 }
 
 void realize_1texture(GLenum target, int wantedTMU, gltexture_t* tex, glsampler_t* sampler)
@@ -785,10 +783,7 @@ void realize_1texture(GLenum target, int wantedTMU, gltexture_t* tex, glsampler_
             wantedTMU=-2;
         }
         DBG(SHUT_LOGD("Adjusting %s[%d]:Texture[%u].min_filter = %s (binded=%u)\n", PrintEnum(target), TMU, tex->glname, PrintEnum(param), glstate->actual_tex2d[TMU]);)
-        if(glstate->gleshard->active!=TMU) {
-            glstate->gleshard->active = TMU;
-            gles_glActiveTexture(GL_TEXTURE0+TMU);
-        }
+        gles_glActiveTexture(GL_TEXTURE0+TMU);
         gles_glTexParameteri(target, GL_TEXTURE_MIN_FILTER, param);
         tex->actual.min_filter=param;
     }
@@ -802,10 +797,7 @@ void realize_1texture(GLenum target, int wantedTMU, gltexture_t* tex, glsampler_
             wantedTMU=-2;
         }
         DBG(SHUT_LOGD("Adjusting %s[%d]:Texture[%u].mag_filter = %s (min=%s/%s)\n", PrintEnum(target), TMU, tex->glname, PrintEnum(param), PrintEnum(sampler->min_filter), PrintEnum(tex->actual.min_filter));)
-        if(glstate->gleshard->active!=TMU) {
-            glstate->gleshard->active = TMU;
-            gles_glActiveTexture(GL_TEXTURE0+TMU);
-        }
+        gles_glActiveTexture(GL_TEXTURE0+TMU);
         gles_glTexParameteri(target, GL_TEXTURE_MAG_FILTER, param);
         tex->actual.mag_filter=param;
     }
@@ -819,10 +811,7 @@ void realize_1texture(GLenum target, int wantedTMU, gltexture_t* tex, glsampler_
             wantedTMU=-2;
         }
         DBG(SHUT_LOGD("Adjusting %s[%d]:Texture[%u].wrap_s = %s\n", PrintEnum(target), TMU, tex->glname, PrintEnum(param));)
-        if(glstate->gleshard->active!=TMU) {
-            glstate->gleshard->active = TMU;
-            gles_glActiveTexture(GL_TEXTURE0+TMU);
-        }
+        gles_glActiveTexture(GL_TEXTURE0+TMU);
         gles_glTexParameteri(target, GL_TEXTURE_WRAP_S, param);
         tex->actual.wrap_s=param;
     }
@@ -836,10 +825,7 @@ void realize_1texture(GLenum target, int wantedTMU, gltexture_t* tex, glsampler_
             wantedTMU=-2;
         }
         DBG(SHUT_LOGD("Adjusting %s[%d]:Texture[%u].wrap_t = %s\n", PrintEnum(target), TMU, tex->glname, PrintEnum(param));)
-        if(glstate->gleshard->active!=TMU) {
-            glstate->gleshard->active = TMU;
-            gles_glActiveTexture(GL_TEXTURE0+TMU);
-        }
+        gles_glActiveTexture(GL_TEXTURE0+TMU);
         gles_glTexParameteri(target, GL_TEXTURE_WRAP_T, param);
         tex->actual.wrap_t=param;
     }
@@ -891,10 +877,7 @@ void realize_textures(int drawing) {
                 || (glstate->bound_stream[i] != tex->streamed)
 #endif
             ) {
-                if(glstate->gleshard->active!=i) {
-                    glstate->gleshard->active = i;
-                    gles_glActiveTexture(GL_TEXTURE0+i);
-                }
+                gles_glActiveTexture(GL_TEXTURE0+i);
 #ifdef TEXSTREAM
                 int streamed = tex->streamed;
                 int streamingID = tex->streamingID;
@@ -0,0 +1,102 @@
+#include "tracer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "logs.h"
+
+// number of spans buffered before writing them to the file
+#define TRACER_BUFFER   4096
+
+typedef struct {
+    const char          *name;
+    unsigned long long  start;
+    unsigned long long  dur;
+    unsigned int        frame;
+    unsigned int        size;
+} trace_span_t;
+
+typedef struct {
+    FILE                *f;
+    trace_span_t        *spans;
+    int                 count;
+    int                 first;      // next event written is the 1st one (no comma)
+    unsigned int        frame;
+    unsigned long long  origin;     // time of the tracer start, all timestamps are relative to it
+    unsigned long long  last_frame;
+    int                 pid;
+} tracer_t;
+
+static tracer_t tracer = {0};
+
+static int tracer_open(unsigned long long start) {
+    tracer.f = fopen(globals4es.trace, "w");
+    tracer.spans = (trace_span_t*)malloc(TRACER_BUFFER*sizeof(trace_span_t));
+    if(!tracer.f || !tracer.spans) {
+        SHUT_LOGE("Cannot open trace file \"%s\", disabling the tracer\n", globals4es.trace);
+        if(tracer.f) fclose(tracer.f);
+        free(tracer.spans);
+        tracer.f = NULL;
+        tracer.spans = NULL;
+        globals4es.trace = NULL;
+        return 0;
+    }
+    tracer.origin = tracer.last_frame = start;
+    tracer.pid = getpid();
+    tracer.first = 1;
+    fprintf(tracer.f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    return 1;
+}
+
+static void tracer_write(const char *name, unsigned long long start, unsigned long long dur, unsigned int frame, unsigned int size) {
+    fprintf(tracer.f, "%s{\"name\":\"%s\",\"cat\":\"gl4es\",\"ph\":\"X\",\"pid\":%d,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u",
+        tracer.first?"":",\n", name, tracer.pid, (start-tracer.origin)*1e-3, dur*1e-3, frame);
+    if(size)
+        fprintf(tracer.f, ",\"size\":%u", size);
+    fprintf(tracer.f, "}}");
+    tracer.first = 0;
+}
+
+static void tracer_flush() {
+    for (int i=0; i<tracer.count; ++i)
+        tracer_write(tracer.spans[i].name, tracer.spans[i].start, tracer.spans[i].dur, tracer.spans[i].frame, tracer.spans[i].size);
+    tracer.count = 0;
+}
+
+void tracer_span(const char *name, unsigned long long t0, unsigned int size) {
+    if(!tracer.f && !tracer_open(t0))
+        return;
+    trace_span_t *span = &tracer.spans[tracer.count++];
+    span->name = name;
+    span->start = t0;
+    span->dur = counters_now()-t0;
+    span->frame = tracer.frame;
+    span->size = size;
+    if(tracer.count==TRACER_BUFFER)
+        tracer_flush();
+}
+
+void tracer_frame() {
+    if(!globals4es.trace)
+        return;
+    unsigned long long now = counters_now();
+    if(!tracer.f && !tracer_open(now))
+        return;
+    // each frame is also a span, so hitches are easy to spot
+    tracer_flush();
+    tracer_write("frame", tracer.last_frame, now-tracer.last_frame, tracer.frame, 0);
+    tracer.last_frame = now;
+    ++tracer.frame;
+}
+
+void tracer_close() {
+    if(!tracer.f)
+        return;
+    tracer_flush();
+    fprintf(tracer.f, "\n]}\n");
+    fclose(tracer.f);
+    free(tracer.spans);
+    tracer.f = NULL;
+    tracer.spans = NULL;
+}
@@ -0,0 +1,21 @@
+#ifndef _GL4ES_TRACER_H_
+#define _GL4ES_TRACER_H_
+
+#include "counters.h"
+#include "init.h"
+
+// Stutter tracer, enabled with LIBGL_TRACE=filename
+// Record spans around the expensive operations, written as Chrome trace-event JSON (open it in chrome://tracing or ui.perfetto.dev)
+
+// record a span from t0 (from TRACE_BEGIN) to now, "size" is an optional info (bytes, vertices...) shown if not 0
+void tracer_span(const char *name, unsigned long long t0, unsigned int size);
+// called once per frame, after the eglSwapBuffers
+void tracer_frame();
+// flush and close the trace file
+void tracer_close();
+
+// only cost a test when the tracer is not enabled
+#define TRACE_BEGIN(t0)             unsigned long long t0 = globals4es.trace?counters_now():0
+#define TRACE_END(t0, name, size)   if(t0) tracer_span(name, t0, size)
+
+#endif // _GL4ES_TRACER_H_
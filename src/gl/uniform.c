@@ -1,6 +1,7 @@
 #include "uniform.h"
 
 #include "../glx/hardext.h"
+#include "counters.h"
 #include "gl4es.h"
 #include "glstate.h"
 #include "loader.h"
@@ -118,16 +119,86 @@ int n_uniform(GLenum type) {
     return 0;
 }
 
+void uniform_resolve(program_t *glprogram)
+{
+    LOAD_GLES2(glUniform1fv);
+    LOAD_GLES2(glUniform2fv);
+    LOAD_GLES2(glUniform3fv);
+    LOAD_GLES2(glUniform4fv);
+    LOAD_GLES2(glUniform1iv);
+    LOAD_GLES2(glUniform2iv);
+    LOAD_GLES2(glUniform3iv);
+    LOAD_GLES2(glUniform4iv);
+    LOAD_GLES2(glUniformMatrix2fv);
+    LOAD_GLES2(glUniformMatrix3fv);
+    LOAD_GLES2(glUniformMatrix4fv);
+    const glUniform1fv_PTR fv[4] = {gles_glUniform1fv, gles_glUniform2fv, gles_glUniform3fv, gles_glUniform4fv};
+    const glUniform1iv_PTR iv[4] = {gles_glUniform1iv, gles_glUniform2iv, gles_glUniform3iv, gles_glUniform4iv};
+    const glUniformMatrix2fv_PTR matrixfv[3] = {gles_glUniformMatrix2fv, gles_glUniformMatrix3fv, gles_glUniformMatrix4fv};
+
+    free(glprogram->uniform_loc);
+    glprogram->uniform_loc = NULL;
+    glprogram->uniform_loc_size = 0;
+    if(!glprogram->uniform)
+        return;
+    uniform_t *m;
+    int count = 0;
+    GLint maxloc = -1;
+    kh_foreach_value(glprogram->uniform, m,
+        m->kind = UNIFORM_OTHER;
+        m->n = n_uniform(m->type);
+        m->upload.fv = NULL;
+        if(is_uniform_matrix(m->type)) {
+            m->kind = UNIFORM_MATRIX;
+            m->n = (m->type==GL_FLOAT_MAT2)?2:((m->type==GL_FLOAT_MAT3)?3:4);
+            m->upload.matrixfv = matrixfv[m->n-2];
+        } else if(m->n && is_uniform_float(m->type)) {
+            m->kind = UNIFORM_FLOAT;
+            m->upload.fv = fv[m->n-1];
+        } else if(m->n && is_uniform_int(m->type)) {
+            m->kind = UNIFORM_INT;
+            m->upload.iv = iv[m->n-1];
+        }
+        ++count;
+        if((GLint)m->id>maxloc)
+            maxloc = m->id;
+    )
+    // drivers usually hand out small consecutive locations, only fall back to the hash lookup if they are really sparse
+    if(maxloc<0 || maxloc>=count*4+64)
+        return;
+    glprogram->uniform_loc_size = maxloc+1;
+    glprogram->uniform_loc = (uniform_t**)calloc(glprogram->uniform_loc_size, sizeof(uniform_t*));
+    kh_foreach_value(glprogram->uniform, m,
+        glprogram->uniform_loc[m->id] = m;
+    )
+}
+
+static inline uniform_t* find_uniform(program_t *glprogram, GLint location)
+{
+    if(glprogram->uniform_loc)
+        return ((GLuint)location<(GLuint)glprogram->uniform_loc_size)?glprogram->uniform_loc[location]:NULL;
+    khint_t k = kh_get(uniformlist, glprogram->uniform, location);
+    return (k==kh_end(glprogram->uniform))?NULL:kh_value(glprogram->uniform, k);
+}
+
+// mark the uniform (and the next array elements written with it) as changed, for fpe_SyncUniforms
+static inline void stamp_uniform(program_t *glprogram, uniform_t *m, GLint location, int count)
+{
+    unsigned int gen = ++glprogram->uniform_gen;
+    m->gen = gen;
+    for (int i=1; i<count; i++) {
+        uniform_t *e = find_uniform(glprogram, location+i);
+        if(e) e->gen = gen;
+    }
+}
+
 void APIENTRY_GL4ES gl4es_glGetUniformfv(GLuint program, GLint location, GLfloat *params) {
     DBG(SHUT_LOGD("glGetUniformfv(%d, %d, %p)\n", program, location, params);)
     FLUSH_BEGINEND;
     CHECK_PROGRAM(void, program);
 
-    khint_t k;
-    uniform_t *gluniform = NULL;
-    k = kh_get(uniformlist, glprogram->uniform, location);
-    if(k!=kh_end(glprogram->uniform)) {
-        gluniform = kh_value(glprogram->uniform, k);
+    uniform_t *gluniform = find_uniform(glprogram, location);
+    if(gluniform) {
         uintptr_t offs = gluniform->cache_offs;
         int size = gluniform->cache_size;
         if(is_uniform_float(gluniform->type)) {
@@ -150,11 +221,8 @@ void APIENTRY_GL4ES gl4es_glGetUniformiv(GLuint program, GLint location, GLint *
     FLUSH_BEGINEND;
     CHECK_PROGRAM(void, program);
 
-    khint_t k;
-    uniform_t *gluniform = NULL;
-    k = kh_get(uniformlist, glprogram->uniform, location);
-    if(k!=kh_end(glprogram->uniform)) {
-        gluniform = kh_value(glprogram->uniform, k);
+    uniform_t *gluniform = find_uniform(glprogram, location);
+    if(gluniform) {
         uintptr_t offs = gluniform->cache_offs;
         int size = gluniform->cache_size;
         if(is_uniform_int(gluniform->type)) {
@@ -185,15 +253,12 @@ void GoUniformfv(program_t *glprogram, GLint location, int size, int count, cons
         return;
     }
 
-    khint_t k;
-    uniform_t *m;
-    k = kh_get(uniformlist, glprogram->uniform, location);
-    if (k==kh_end(glprogram->uniform)) {
+    uniform_t *m = find_uniform(glprogram, location);
+    if (!m) {
         errorShim(GL_INVALID_OPERATION);
         return;
     }
-    m = kh_value(glprogram->uniform, k);
-    if(size != n_uniform(m->type) || !is_uniform_float(m->type) || count>m->size) {
+    if(m->kind!=UNIFORM_FLOAT || size!=m->n || count>m->size) {
         errorShim(GL_INVALID_OPERATION);
         return;
     }
@@ -201,21 +266,15 @@ void GoUniformfv(program_t *glprogram, GLint location, int size, int count, cons
     int rsize = sizeof(GLfloat)*size*count;
     if (memcmp((char*)glprogram->cache.cache + m->cache_offs, value, rsize)==0) {
         noerrorShim();
+        COUNTER_INC(uniforms_skipped);
         return; // nothing to do, same value already there
     }
     // update uniform
     memcpy((char*)glprogram->cache.cache + m->cache_offs, value, rsize);
-    LOAD_GLES2(glUniform1fv);
-    LOAD_GLES2(glUniform2fv);
-    LOAD_GLES2(glUniform3fv);
-    LOAD_GLES2(glUniform4fv);
-    if(gles_glUniform1fv) {
-        switch (size) {
-            case 1: gles_glUniform1fv(m->id, count, value); break;
-            case 2: gles_glUniform2fv(m->id, count, value); break;
-            case 3: gles_glUniform3fv(m->id, count, value); break;
-            case 4: gles_glUniform4fv(m->id, count, value); break;
-        }
+    stamp_uniform(glprogram, m, location, count);
+    COUNTER_INC(uniforms_sent);
+    if(m->upload.fv) {
+        m->upload.fv(m->id, count, value);
         errorGL();
     } else
         errorShim(GL_INVALID_OPERATION);    // no GLLS hardware
@@ -232,15 +291,12 @@ void GoUniformiv(program_t *glprogram, GLint location, int size, int count, cons
         return;
     }
 
-    khint_t k;
-    uniform_t *m;
-    k = kh_get(uniformlist, glprogram->uniform, location);
-    if (k==kh_end(glprogram->uniform)) {
+    uniform_t *m = find_uniform(glprogram, location);
+    if (!m) {
         errorShim(GL_INVALID_OPERATION);
         return;
     }
-    m = kh_value(glprogram->uniform, k);
-    if(size != n_uniform(m->type) || !is_uniform_int(m->type)  || count>m->size) {
+    if(m->kind!=UNIFORM_INT || size!=m->n || count>m->size) {
         errorShim(GL_INVALID_OPERATION);
         return;
     }
@@ -248,22 +304,16 @@ void GoUniformiv(program_t *glprogram, GLint location, int size, int count, cons
     int rsize = sizeof(GLint)*size*count;
     if (memcmp((char*)glprogram->cache.cache + m->cache_offs, value, rsize)==0) {
         noerrorShim();
+        COUNTER_INC(uniforms_skipped);
         return; // nothing to do, same value already there
     }
     DBG(SHUT_LOGD("Uniform updated, cache=%p(%d/%d), offset=%p, size=%d\n", glprogram->cache.cache, glprogram->cache.size, glprogram->cache.cap, (void*)m->cache_offs, rsize);)
     // update uniform
     memcpy((char*)glprogram->cache.cache + m->cache_offs, value, rsize);
-    LOAD_GLES2(glUniform1iv);
-    LOAD_GLES2(glUniform2iv);
-    LOAD_GLES2(glUniform3iv);
-    LOAD_GLES2(glUniform4iv);
-    if(gles_glUniform1iv) {
-        switch (size) {
-            case 1: gles_glUniform1iv(m->id, count, value); break;
-            case 2: gles_glUniform2iv(m->id, count, value); break;
-            case 3: gles_glUniform3iv(m->id, count, value); break;
-            case 4: gles_glUniform4iv(m->id, count, value); break;
-        }
+    stamp_uniform(glprogram, m, location, count);
+    COUNTER_INC(uniforms_sent);
+    if(m->upload.iv) {
+        m->upload.iv(m->id, count, value);
         errorGL();
     } else
         errorShim(GL_INVALID_OPERATION);    // no GLLS hardware
@@ -544,15 +594,12 @@ void GoUniformMatrix2fv(program_t *glprogram, GLint location, GLsizei count, GLb
         errorShim(GL_INVALID_VALUE);
         return;
     }
-    khint_t k;
-    uniform_t *m;
-    k = kh_get(uniformlist, glprogram->uniform, location);
-    if (k==kh_end(glprogram->uniform)) {
+    uniform_t *m = find_uniform(glprogram, location);
+    if (!m) {
         errorShim(GL_INVALID_OPERATION);
         return;
     }
-    m = kh_value(glprogram->uniform, k);
-    if(m->type!=GL_FLOAT_MAT2  || count>m->size) {
+    if(m->kind!=UNIFORM_MATRIX || m->n!=2 || count>m->size) {
         errorShim(GL_INVALID_OPERATION);
         return;
     }
@@ -571,13 +618,15 @@ void GoUniformMatrix2fv(program_t *glprogram, GLint location, GLsizei count, GLb
     int rsize = sizeof(GLfloat)*2*2*count;
     if (memcmp((char*)glprogram->cache.cache + m->cache_offs, v, rsize)==0) {
         noerrorShim();
+        COUNTER_INC(uniforms_skipped);
         return; // nothing to do, same value already there
     }
     // update uniform
     memcpy((char*)glprogram->cache.cache + m->cache_offs, v, rsize);
-    LOAD_GLES2(glUniformMatrix2fv);
-    if (gles_glUniformMatrix2fv) {
-        gles_glUniformMatrix2fv(m->id, count, GL_FALSE, v);
+    stamp_uniform(glprogram, m, location, count);
+    COUNTER_INC(uniforms_sent);
+    if (m->upload.matrixfv) {
+        m->upload.matrixfv(m->id, count, GL_FALSE, v);
         errorGL();
     } else
         errorShim(GL_INVALID_OPERATION);    // no GLSL hardware
@@ -610,15 +659,12 @@ void GoUniformMatrix3fv(program_t *glprogram, GLint location, GLsizei count, GLb
         errorShim(GL_INVALID_VALUE);
         return;
     }
-    khint_t k;
-    uniform_t *m;
-    k = kh_get(uniformlist, glprogram->uniform, location);
-    if (k==kh_end(glprogram->uniform)) {
+    uniform_t *m = find_uniform(glprogram, location);
+    if (!m) {
         errorShim(GL_INVALID_OPERATION);
         return;
     }
-    m = kh_value(glprogram->uniform, k);
-    if(m->type!=GL_FLOAT_MAT3  || count>m->size) {
+    if(m->kind!=UNIFORM_MATRIX || m->n!=3 || count>m->size) {
         errorShim(GL_INVALID_OPERATION);
         return;
     }
@@ -637,13 +683,15 @@ void GoUniformMatrix3fv(program_t *glprogram, GLint location, GLsizei count, GLb
     int rsize = sizeof(GLfloat)*3*3*count;
     if (memcmp((char*)glprogram->cache.cache + m->cache_offs, v, rsize)==0) {
         noerrorShim();
+        COUNTER_INC(uniforms_skipped);
         return; // nothing to do, same value already there
     }
     // update uniform
     memcpy((char*)glprogram->cache.cache + m->cache_offs, v, rsize);
-    LOAD_GLES2(glUniformMatrix3fv);
-    if (gles_glUniformMatrix3fv) {
-        gles_glUniformMatrix3fv(m->id, count, GL_FALSE, v);
+    stamp_uniform(glprogram, m, location, count);
+    COUNTER_INC(uniforms_sent);
+    if (m->upload.matrixfv) {
+        m->upload.matrixfv(m->id, count, GL_FALSE, v);
         errorGL();
     } else
         errorShim(GL_INVALID_OPERATION);    // no GLSL hardware
@@ -674,15 +722,12 @@ void GoUniformMatrix4fv(program_t *glprogram, GLint location, GLsizei count, GLb
         errorShim(GL_INVALID_VALUE);
         return;
     }
-    khint_t k;
-    uniform_t *m;
-    k = kh_get(uniformlist, glprogram->uniform, location);
-    if (k==kh_end(glprogram->uniform)) {
+    uniform_t *m = find_uniform(glprogram, location);
+    if (!m) {
         errorShim(GL_INVALID_OPERATION);
         return;
     }
-    m = kh_value(glprogram->uniform, k);
-    if(m->type!=GL_FLOAT_MAT4  || count>m->size) {
+    if(m->kind!=UNIFORM_MATRIX || m->n!=4 || count>m->size) {
         errorShim(GL_INVALID_OPERATION);
         return;
     }
@@ -699,13 +744,15 @@ void GoUniformMatrix4fv(program_t *glprogram, GLint location, GLsizei count, GLb
     int rsize = sizeof(GLfloat)*4*4*count;
     if (memcmp((char*)glprogram->cache.cache + m->cache_offs, v, rsize)==0) {
         noerrorShim();
+        COUNTER_INC(uniforms_skipped);
         return; // nothing to do, same value already there
     }
     // update uniform
     memcpy((char*)glprogram->cache.cache + m->cache_offs, v, rsize);
-    LOAD_GLES2(glUniformMatrix4fv);
-    if (gles_glUniformMatrix4fv) {
-        gles_glUniformMatrix4fv(m->id, count, GL_FALSE, v);
+    stamp_uniform(glprogram, m, location, count);
+    COUNTER_INC(uniforms_sent);
+    if (m->upload.matrixfv) {
+        m->upload.matrixfv(m->id, count, GL_FALSE, v);
         errorGL();
     } else {
         //printf("No GLES2 function\n");
@@ -720,13 +767,10 @@ int GetUniformi(program_t *glprogram, GLint location)
         return 0;
     }
 
-    khint_t k;
-    uniform_t *m;
-    k = kh_get(uniformlist, glprogram->uniform, location);
-    if (k==kh_end(glprogram->uniform)) {
+    uniform_t *m = find_uniform(glprogram, location);
+    if (!m) {
         return 0;
     }
-    m = kh_value(glprogram->uniform, k);
 
     // ok, grab the value in the cache
     GLint ret;
@@ -741,13 +785,10 @@ const char* GetUniformName(program_t *glprogram, GLint location)
         return 0;
     }
 
-    khint_t k;
-    uniform_t *m;
-    k = kh_get(uniformlist, glprogram->uniform, location);
-    if (k==kh_end(glprogram->uniform)) {
+    uniform_t *m = find_uniform(glprogram, location);
+    if (!m) {
         return 0;
     }
-    m = kh_value(glprogram->uniform, k);
 
     // ok, grab the value in the cache
     return m->name;
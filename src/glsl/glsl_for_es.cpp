@@ -173,12 +173,12 @@ char* disable_GL_ARB_derivative_control(char* glslCode) {
 
         code = removeSecondLine(code);
 
-        char* result = new char[code.length() + 1];
+        char* result = (char*)malloc(code.length() + 1);
         std::strcpy(result, code.c_str());
         return result;
     }
 
-    char* result = new char[code.length() + 1];
+    char* result = (char*)malloc(code.length() + 1);
     std::strcpy(result, code.c_str());
     return result;
 }
@@ -419,7 +419,8 @@ char* GLSLtoGLSLES(char* glsl_code, GLenum glsl_type, uint essl_version) {
     //essl = addPrecisionToSampler2DShadow(essl);
     essl = forceSupporter(essl);
 
-    char* result_essl = new char[essl.length() + 1];
+    // malloc'd, so C callers can free it
+    char* result_essl = (char*)malloc(essl.length() + 1);
     std::strcpy(result_essl, essl.c_str());
 
     DBG(SHUT_LOGD("GLSL to GLSL ES Complete: \n%s",result_essl))
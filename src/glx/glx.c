@@ -25,10 +25,13 @@
 #ifdef AMIGAOS4
 #include "../agl/amigaos.h"
 #endif // AMIGAOS4
+#include "../gl/counters.h"
 #include "../gl/debug.h"
 #include "../gl/framebuffers.h"
 #include "../gl/init.h"
 #include "../gl/loader.h"
+#include "../gl/perflog.h"
+#include "../gl/tracer.h"
 #ifdef PANDORA
 #include "../gl/pixel.h"
 #endif
@@ -1506,7 +1509,7 @@ void gl4es_glXSwapBuffers(Display *display,
     LOAD_EGL(eglSwapBuffers);
     // TODO: what if active context is not on the drawable?
     realize_textures(0);
-    if (glstate->list.active){
+    if (glstate->list.active || glstate->list.pending){
         gl4es_flush();
     }
     if (glstate->raster.bm_drawing)
@@ -1630,6 +1633,7 @@ void gl4es_glXSwapBuffers(Display *display,
         }
         last_frame = now;
     }
+    end_frame(1);
     if (globals4es.usefbo && PBuffer==0) {
         bindMainFBO();
     }
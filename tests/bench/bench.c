@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gl4esinit.h>
+#include <gl4esnulldrv.h>
+
+#include "bench.h"
+
+// usage: gl4es_bench [-s scale] [filter]
+//  scale multiply the number of iterations of all the bench (default 1)
+//  filter only run bench with that substring in their name
+// Bench are run on the null GLES driver, so only gl4es CPU time is measured
+
+const char* bench_filter = NULL;
+
+static const bench_t benchs[] = {
+    {"drawing", bench_drawing},
+    {"indices", bench_indices},
+    {"pixel", bench_pixel},
+    {"shader", bench_shader},
+    {"uniform", bench_uniform},
+};
+
+void bench_report(const char* name, long iter, uint64_t ns, double items, const char* unit) {
+    double secs = ns*1e-9;
+    double rate = (secs>0.)?items/secs:0.;
+    const char* prefix = "";
+    if(rate>=1e9) {rate*=1e-9; prefix="G";}
+    else if(rate>=1e6) {rate*=1e-6; prefix="M";}
+    else if(rate>=1e3) {rate*=1e-3; prefix="K";}
+    printf("%-48s %10ld op %12.1f ns/op %10.2f %s%s/s\n", name, iter, (double)ns/iter, rate, prefix, unit);
+}
+
+int main(int argc, const char** argv) {
+    int scale = 1;
+    for (int i=1; i<argc; ++i) {
+        if(!strcmp(argv[i], "-s") && i+1<argc)
+            scale = atoi(argv[++i]);
+        else
+            bench_filter = argv[i];
+    }
+    if(scale<1) scale = 1;
+    setenv("LIBGL_NULLDRIVER", "1", 0);
+    setenv("LIBGL_NOBANNER", "1", 0);
+    initialize_gl4es();
+
+    for (int i=0; i<sizeof(benchs)/sizeof(benchs[0]); ++i)
+        benchs[i].run(scale);
+
+    gl4es_nulldrv_stats_t stats;
+    gl4es_nulldrv_getstats(&stats);
+    printf("GLES calls: %llu, draws: %llu, vertices: %llu, buffer bytes: %llu, texture bytes: %llu\n",
+        stats.calls, stats.draws, stats.vertices, stats.buffer_bytes, stats.texture_bytes);
+    return 0;
+}
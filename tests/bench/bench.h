@@ -0,0 +1,43 @@
+#ifndef _GL4ES_BENCH_H_
+#define _GL4ES_BENCH_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Tiny microbenchmark harness: each bench time a loop of "iter" operations
+// and report ns/op and a throughput in "unit"/s (items or bytes processed by the loop)
+
+typedef struct {
+    const char* name;
+    void (*run)(int scale);
+} bench_t;
+
+extern const char* bench_filter;
+
+static inline uint64_t bench_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000ULL + ts.tv_nsec;
+}
+
+void bench_report(const char* name, long iter, uint64_t ns, double items, const char* unit);
+
+// time the code (last arguments) run "iter" times, each iteration process "items" of "unit"
+#define BENCH_LOOP(name, iter, items, unit, ...)                        \
+    if(!bench_filter || strstr(name, bench_filter)) {                   \
+        long bench_iter = (iter);                                       \
+        uint64_t bench_t0 = bench_now();                                \
+        for (long bench_i=0; bench_i<bench_iter; ++bench_i) { __VA_ARGS__ } \
+        bench_report(name, bench_iter, bench_now()-bench_t0,            \
+            (double)(items)*bench_iter, unit);                          \
+    }
+
+void bench_drawing(int scale);
+void bench_indices(int scale);
+void bench_pixel(int scale);
+void bench_shader(int scale);
+void bench_uniform(int scale);
+
+#endif // _GL4ES_BENCH_H_
@@ -0,0 +1,151 @@
+#include <stdlib.h>
+
+#include "../../src/gl/counters.h"
+#include "../../src/gl/gl4es.h"
+#include "../../src/gl/init.h"
+#include "../../src/gl/wrap/gl4es.h"
+
+#include "bench.h"
+
+#define QUADS   256
+
+static void bench_beginend(int scale) {
+    // 256 textured / colored quads per glBegin/glEnd block
+    BENCH_LOOP("glBegin/glEnd GL_QUADS (256 quads)", 2000*scale, QUADS*4, "vertex",
+        gl4es_glBegin(GL_QUADS);
+        for (int q=0; q<QUADS; ++q) {
+            float x = (float)(q&15), y = (float)(q>>4);
+            gl4es_glColor4f(1.f, 0.5f, 0.25f, 1.f);
+            gl4es_glTexCoord2f(0.f, 0.f); gl4es_glVertex3f(x, y, 0.f);
+            gl4es_glTexCoord2f(1.f, 0.f); gl4es_glVertex3f(x+1.f, y, 0.f);
+            gl4es_glTexCoord2f(1.f, 1.f); gl4es_glVertex3f(x+1.f, y+1.f, 0.f);
+            gl4es_glTexCoord2f(0.f, 1.f); gl4es_glVertex3f(x, y+1.f, 0.f);
+        }
+        gl4es_glEnd();
+    )
+}
+
+static void bench_listpool(int scale) {
+    // many small glBegin/glEnd blocks (1 renderlist each), with and without recycling of the renderlists,
+    // and the heap allocations done for them per iteration once warm
+    static const char* names[2] = {"glBegin/glEnd 64 x 1 quad (LIBGL_LISTPOOL=0)", "glBegin/glEnd 64 x 1 quad (LIBGL_LISTPOOL=1)"};
+    int old = globals4es.listpool;
+    for (int pool=0; pool<2; ++pool) {
+        if(bench_filter && !strstr(names[pool], bench_filter))
+            continue;
+        globals4es.listpool = pool;
+        #define BLOCKS \
+        for (int q=0; q<64; ++q) { \
+            float x = (float)(q&7), y = (float)(q>>3); \
+            gl4es_glBegin(GL_QUADS); \
+            gl4es_glColor4f(1.f, 0.5f, 0.25f, 1.f); \
+            gl4es_glTexCoord2f(0.f, 0.f); gl4es_glVertex3f(x, y, 0.f); \
+            gl4es_glTexCoord2f(1.f, 0.f); gl4es_glVertex3f(x+1.f, y, 0.f); \
+            gl4es_glTexCoord2f(1.f, 1.f); gl4es_glVertex3f(x+1.f, y+1.f, 0.f); \
+            gl4es_glTexCoord2f(0.f, 1.f); gl4es_glVertex3f(x, y+1.f, 0.f); \
+            gl4es_glEnd(); \
+        } \
+        gl4es_flush();
+        BLOCKS  // warm up the pool
+        gl4es_counters_t c0, c1;
+        gl4es_getcounters(GL4ES_COUNTERS_TOTAL, &c0);
+        long iter = 2000*scale;
+        BENCH_LOOP(names[pool], iter, 64*4, "vertex",
+            BLOCKS
+        )
+        #undef BLOCKS
+        gl4es_getcounters(GL4ES_COUNTERS_TOTAL, &c1);
+        printf("%-48s %10.2f allocs/op %8.2f recycled/op\n", "", (double)(c1.list_allocs-c0.list_allocs)/iter,
+            (double)(c1.list_recycled-c0.list_recycled)/iter);
+    }
+    globals4es.listpool = old;
+}
+
+static void bench_quads(int scale) {
+    GLfloat *vert = (GLfloat*)malloc(QUADS*4*3*sizeof(GLfloat));
+    GLfloat *tex = (GLfloat*)malloc(QUADS*4*2*sizeof(GLfloat));
+    GLushort *ind = (GLushort*)malloc(QUADS*4*sizeof(GLushort));
+    for (int i=0; i<QUADS*4; ++i) {
+        vert[i*3+0] = (float)(i&63); vert[i*3+1] = (float)(i>>6); vert[i*3+2] = 0.f;
+        tex[i*2+0] = (float)(i&1); tex[i*2+1] = (float)((i>>1)&1);
+        ind[i] = i;
+    }
+    gl4es_glEnableClientState(GL_VERTEX_ARRAY);
+    gl4es_glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    gl4es_glVertexPointer(3, GL_FLOAT, 0, vert);
+    gl4es_glTexCoordPointer(2, GL_FLOAT, 0, tex);
+
+    BENCH_LOOP("glDrawArrays GL_QUADS (256 quads)", 20000*scale, QUADS*4, "vertex",
+        gl4es_glDrawArrays(GL_QUADS, 0, QUADS*4);
+    )
+    BENCH_LOOP("glDrawElements GL_QUADS (256 quads)", 20000*scale, QUADS*4, "vertex",
+        gl4es_glDrawElements(GL_QUADS, QUADS*4, GL_UNSIGNED_SHORT, ind);
+    )
+    BENCH_LOOP("glDrawElements GL_TRIANGLES (256 quads)", 20000*scale, QUADS*4, "vertex",
+        gl4es_glDrawElements(GL_TRIANGLES, QUADS*3, GL_UNSIGNED_SHORT, ind);
+    )
+
+    gl4es_glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    gl4es_glDisableClientState(GL_VERTEX_ARRAY);
+    free(ind);
+    free(tex);
+    free(vert);
+}
+
+static void bench_smalldraws(int scale) {
+    // 1 quad per glDrawArrays or glDrawElements (sprites, text...), with and without the draws merger
+    GLfloat *vert = (GLfloat*)malloc(QUADS*4*3*sizeof(GLfloat));
+    GLfloat *tex = (GLfloat*)malloc(QUADS*4*2*sizeof(GLfloat));
+    for (int i=0; i<QUADS*4; ++i) {
+        vert[i*3+0] = (float)(i&63); vert[i*3+1] = (float)(i>>6); vert[i*3+2] = 0.f;
+        tex[i*2+0] = (float)(i&1); tex[i*2+1] = (float)((i>>1)&1);
+    }
+    gl4es_glEnableClientState(GL_VERTEX_ARRAY);
+    gl4es_glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    gl4es_glVertexPointer(3, GL_FLOAT, 0, vert);
+    gl4es_glTexCoordPointer(2, GL_FLOAT, 0, tex);
+
+    int old = globals4es.drawmerge;
+    globals4es.drawmerge = 0;
+    BENCH_LOOP("glDrawArrays GL_QUADS (256 x 1 quad)", 2000*scale, QUADS*4, "vertex",
+        for (int q=0; q<QUADS; ++q)
+            gl4es_glDrawArrays(GL_QUADS, q*4, 4);
+    )
+    globals4es.drawmerge = 4;
+    BENCH_LOOP("glDrawArrays GL_QUADS (256 x 1 quad, LIBGL_DRAWMERGE)", 2000*scale, QUADS*4, "vertex",
+        for (int q=0; q<QUADS; ++q)
+            gl4es_glDrawArrays(GL_QUADS, q*4, 4);
+        gl4es_flush();
+    )
+    // same with GL_UNSIGNED_BYTE indices (merged without going through the GLushort conversion)
+    GLubyte *ind = (GLubyte*)malloc(QUADS/4*6);
+    for (int q=0; q<QUADS/4; ++q) {
+        ind[q*6+0] = q*4+0; ind[q*6+1] = q*4+1; ind[q*6+2] = q*4+2;
+        ind[q*6+3] = q*4+0; ind[q*6+4] = q*4+2; ind[q*6+5] = q*4+3;
+    }
+    globals4es.drawmerge = 0;
+    BENCH_LOOP("glDrawElements GL_UNSIGNED_BYTE (64 x 1 quad)", 8000*scale, QUADS, "vertex",
+        for (int q=0; q<QUADS/4; ++q)
+            gl4es_glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, ind+q*6);
+    )
+    globals4es.drawmerge = 4;
+    BENCH_LOOP("glDrawElements GL_UNSIGNED_BYTE (64 x 1 quad, LIBGL_DRAWMERGE)", 8000*scale, QUADS, "vertex",
+        for (int q=0; q<QUADS/4; ++q)
+            gl4es_glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, ind+q*6);
+        gl4es_flush();
+    )
+    globals4es.drawmerge = old;
+    free(ind);
+
+    gl4es_glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    gl4es_glDisableClientState(GL_VERTEX_ARRAY);
+    free(tex);
+    free(vert);
+}
+
+void bench_drawing(int scale) {
+    bench_beginend(scale);
+    bench_listpool(scale);
+    bench_quads(scale);
+    bench_smalldraws(scale);
+}
@@ -0,0 +1,49 @@
+#include <stdlib.h>
+
+#include "../../src/gl/gl4es.h"
+#include "../../src/gl/array.h"
+
+#include "bench.h"
+
+// index range scans (getminmax_indices_us/ui), C and SIMD versions, on index lists of various sizes
+
+static const int sizes[] = {96, 1536, 24576, 393216};
+
+static void bench_scans(const char* impl, int scale, const GLushort* sind, const GLuint* iind) {
+    char name[100];
+    GLsizei min, max;
+    for (int s=0; s<sizeof(sizes)/sizeof(sizes[0]); ++s) {
+        int count = sizes[s];
+        long iter = (long)scale*(100000000/count/8+1);
+        snprintf(name, sizeof(name), "getminmax_indices_us %s (%d)", impl, count);
+        BENCH_LOOP(name, iter, count, "index",
+            getminmax_indices_us(sind, &max, &min, count);
+        )
+        snprintf(name, sizeof(name), "getminmax_indices_ui %s (%d)", impl, count);
+        BENCH_LOOP(name, iter, count, "index",
+            getminmax_indices_ui(iind, &max, &min, count);
+        )
+    }
+}
+
+void bench_indices(int scale) {
+    int count = sizes[sizeof(sizes)/sizeof(sizes[0])-1];
+    GLushort *sind = (GLushort*)malloc(count*sizeof(GLushort));
+    GLuint *iind = (GLuint*)malloc(count*sizeof(GLuint));
+    // a mesh like pattern: triangles of a 256 wide grid
+    for (int i=0; i<count; ++i) {
+        int q = i/6, c = i%6;
+        int v = (q>>1) + ((c==1 || c==4)?1:0) + ((c==2 || c==3)?256:0) + ((c==4 || c==5)?257:0);
+        sind[i] = (GLushort)v;
+        iind[i] = v;
+    }
+
+    select_indices_scan(0);
+    bench_scans("C", scale, sind, iind);
+    const char* impl = select_indices_scan(1);
+    if(strcmp(impl, "C"))
+        bench_scans(impl, scale, sind, iind);
+
+    free(iind);
+    free(sind);
+}
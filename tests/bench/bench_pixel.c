@@ -0,0 +1,51 @@
+#include <stdlib.h>
+
+#include "../../src/gl/gl4es.h"
+#include "../../src/gl/pixel.h"
+
+#include "bench.h"
+
+// from texture_compressed.c
+GLvoid *uncompressDXTc(GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, int transparent0, int* simpleAlpha, int* complexAlpha, const GLvoid *data);
+
+#define W   256
+#define H   256
+
+static void bench_convert(const char* name, int iter, const GLvoid* src, GLenum src_format, GLenum src_type, GLenum dst_format, GLenum dst_type, void* dst) {
+    BENCH_LOOP(name, iter, W*H*4, "pixel",
+        GLvoid *d = dst;
+        pixel_convert(src, &d, W, H, src_format, src_type, dst_format, dst_type, 0, 1);
+    )
+}
+
+void bench_pixel(int scale) {
+    GLubyte *rgba = (GLubyte*)malloc(W*H*4);
+    GLfloat *rgbaf = (GLfloat*)malloc(W*H*4*sizeof(GLfloat));
+    void *dst = malloc(W*H*4*sizeof(GLfloat));
+    for (int i=0; i<W*H*4; ++i) {
+        rgba[i] = (GLubyte)(i*7);
+        rgbaf[i] = (i&255)/255.f;
+    }
+    // fast paths
+    bench_convert("pixel_convert BGRA8->RGBA8 256x256", 200*scale, rgba, GL_BGRA, GL_UNSIGNED_BYTE, GL_RGBA, GL_UNSIGNED_BYTE, dst);
+    bench_convert("pixel_convert RGBA8->RGB565 256x256", 200*scale, rgba, GL_RGBA, GL_UNSIGNED_BYTE, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, dst);
+    bench_convert("pixel_convert RGBA8->RGBA4444 256x256", 200*scale, rgba, GL_RGBA, GL_UNSIGNED_BYTE, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, dst);
+    // generic remap_pixel path
+    bench_convert("pixel_convert (remap) RGBAf->RGBA8 256x256", 50*scale, rgbaf, GL_RGBA, GL_FLOAT, GL_RGBA, GL_UNSIGNED_BYTE, dst);
+    bench_convert("pixel_convert (remap) LUMINANCE_ALPHA8->RGBA8 256x256", 50*scale, rgba, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, GL_RGBA, GL_UNSIGNED_BYTE, dst);
+
+    // DXTc, random blocks are fine
+    int simpleAlpha, complexAlpha;
+    BENCH_LOOP("uncompressDXTc DXT1 256x256", 200*scale, W*H, "pixel",
+        GLvoid *p = uncompressDXTc(W, H, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, W*H/2, 0, &simpleAlpha, &complexAlpha, rgba);
+        free(p);
+    )
+    BENCH_LOOP("uncompressDXTc DXT5 256x256", 200*scale, W*H, "pixel",
+        GLvoid *p = uncompressDXTc(W, H, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, W*H, 0, &simpleAlpha, &complexAlpha, rgba);
+        free(p);
+    )
+
+    free(dst);
+    free(rgbaf);
+    free(rgba);
+}
@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../src/gl/gl4es.h"
+#include "../../src/gl/fpe.h"
+#include "../../src/gl/fpe_cache.h"
+#include "../../src/gl/shader.h"
+#include "../../src/gl/shaderconv.h"
+#include "../../src/glsl/glsl_for_es.h"
+
+#include "bench.h"
+
+static const char* vert120 =
+"#version 120\n"
+"varying vec2 uv;\n"
+"varying vec4 col;\n"
+"uniform float time;\n"
+"void main() {\n"
+"   uv = gl_MultiTexCoord0.xy;\n"
+"   col = gl_Color * vec4(sin(time), 1.0, 1.0, 1.0);\n"
+"   gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+"}\n";
+
+static const char* frag120 =
+"#version 120\n"
+"varying vec2 uv;\n"
+"varying vec4 col;\n"
+"uniform sampler2D tex;\n"
+"void main() {\n"
+"   gl_FragColor = texture2D(tex, uv) * col;\n"
+"}\n";
+
+static const char* vert330 =
+"#version 330 core\n"
+"layout(location = 0) in vec3 pos;\n"
+"layout(location = 1) in vec2 tc;\n"
+"uniform mat4 mvp;\n"
+"out vec2 uv;\n"
+"void main() {\n"
+"   uv = tc;\n"
+"   gl_Position = mvp * vec4(pos, 1.0);\n"
+"}\n";
+
+static void bench_convertshader(int scale) {
+    BENCH_LOOP("ConvertShader vertex #version 120", 2000*scale, 1, "shader",
+        shaderconv_need_t need = {0};
+        need.need_texcoord = -1;
+        free(ConvertShader(vert120, 1, &need, 0));
+    )
+    BENCH_LOOP("ConvertShader fragment #version 120", 2000*scale, 1, "shader",
+        shaderconv_need_t need = {0};
+        need.need_texcoord = -1;
+        free(ConvertShader(frag120, 0, &need, 0));
+    )
+}
+
+static void bench_glsltoglsles(int scale) {
+    BENCH_LOOP("GLSLtoGLSLES vertex #version 330", 50*scale, 1, "shader",
+        // GLSLtoGLSLES takes a non-const source
+        char* src = strdup(vert330);
+        // result is malloc'd
+        free(GLSLtoGLSLES(src, GL_VERTEX_SHADER, 300));
+        free(src);
+    )
+}
+
+static void bench_fpecache(int scale) {
+    // a cache with 64 different states, looked up in turn
+    #define NSTATES 64
+    fpe_cache_t *cache = fpe_NewCache();
+    fpe_state_t *states = (fpe_state_t*)calloc(NSTATES, sizeof(fpe_state_t));
+    for (int i=0; i<NSTATES; ++i) {
+        states[i].vertex_prg_id = i;
+        states[i].lighting = i&1;
+        states[i].fog = (i>>1)&1;
+        fpe_GetCache(cache, &states[i], 0);
+    }
+    BENCH_LOOP("fpe_GetCache lookup (64 states)", 1000000*scale, 1, "lookup",
+        fpe_GetCache(cache, &states[bench_i&(NSTATES-1)], 0);
+    )
+    fpe_disposeCache(cache, 0);
+    free(states);
+    #undef NSTATES
+}
+
+void bench_shader(int scale) {
+    bench_convertshader(scale);
+    bench_glsltoglsles(scale);
+    bench_fpecache(scale);
+}
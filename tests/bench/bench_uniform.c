@@ -0,0 +1,83 @@
+#include <stdlib.h>
+
+#include "../../src/gl/gl4es.h"
+#include "../../src/gl/glstate.h"
+#include "../../src/gl/program.h"
+#include "../../src/gl/shader.h"
+
+#include "bench.h"
+
+// uniform uploads through GoUniform*, with the location table and with the hash lookup fallback
+// the program is compiled and linked on the null driver, that reports the uniforms declared in the shaders
+
+#define NUNIFORMS   64  // 1 mat4 then 3 vec4, repeated
+
+static GLint locs[NUNIFORMS];
+
+static void bench_uploads(const char* lookup, int scale, program_t *glprogram) {
+    char name[100];
+    GLfloat values[2][16] = {{1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f}, {2.f}};
+    // first pass send the values, the timed loops then only hit the cache
+    for (int i=0; i<NUNIFORMS; ++i)
+        if(i%4)
+            GoUniformfv(glprogram, locs[i], 4, 1, values[0]);
+        else
+            GoUniformMatrix4fv(glprogram, locs[i], 1, GL_FALSE, values[0]);
+    snprintf(name, sizeof(name), "GoUniformfv vec4 unchanged (%s)", lookup);
+    BENCH_LOOP(name, 5000000L*scale, 1, "uniform",
+        GoUniformfv(glprogram, locs[(bench_i&(NUNIFORMS-1))|1], 4, 1, values[0]);
+    )
+    snprintf(name, sizeof(name), "GoUniformMatrix4fv unchanged (%s)", lookup);
+    BENCH_LOOP(name, 5000000L*scale, 1, "uniform",
+        GoUniformMatrix4fv(glprogram, locs[bench_i&(NUNIFORMS-4)], 1, GL_FALSE, values[0]);
+    )
+    // each upload changes the value, so it goes down to the driver
+    snprintf(name, sizeof(name), "GoUniformfv vec4 changed (%s)", lookup);
+    BENCH_LOOP(name, 2000000L*scale, 1, "uniform",
+        GoUniformfv(glprogram, locs[1], 4, 1, values[bench_i&1]);
+    )
+}
+
+static GLuint compile_shader(GLenum type, const char* source) {
+    GLuint shader = gl4es_glCreateShader(type);
+    gl4es_glShaderSource(shader, 1, &source, NULL);
+    gl4es_glCompileShader(shader);
+    return shader;
+}
+
+void bench_uniform(int scale) {
+    char vert[NUNIFORMS*24+64] = "#version 120\n";
+    for (int i=0; i<NUNIFORMS; ++i)
+        snprintf(vert+strlen(vert), sizeof(vert)-strlen(vert), "uniform %s u%d;\n", (i%4)?"vec4":"mat4", i);
+    strcat(vert, "void main() {\n gl_Position = vec4(0.);\n}\n");
+    GLuint vs = compile_shader(GL_VERTEX_SHADER, vert);
+    GLuint fs = compile_shader(GL_FRAGMENT_SHADER, "#version 120\nvoid main() {\n gl_FragColor = vec4(1.);\n}\n");
+    GLuint program = gl4es_glCreateProgram();
+    gl4es_glAttachShader(program, vs);
+    gl4es_glAttachShader(program, fs);
+    gl4es_glLinkProgram(program);
+    program_t *glprogram = NULL;
+    khint_t k = kh_get(programlist, glstate->glsl->programs, program);
+    if(k!=kh_end(glstate->glsl->programs))
+        glprogram = kh_value(glstate->glsl->programs, k);
+    for (int i=0; i<NUNIFORMS; ++i) {
+        char name[16];
+        snprintf(name, sizeof(name), "u%d", i);
+        locs[i] = gl4es_glGetUniformLocation(program, name);
+    }
+    if(!glprogram || locs[NUNIFORMS-1]==-1) {
+        printf("bench_uniform: no active uniform in the linked program\n");
+    } else {
+        bench_uploads("location table", scale, glprogram);
+        // same program, without the table
+        uniform_t **table = glprogram->uniform_loc;
+        glprogram->uniform_loc = NULL;
+        memset(glprogram->cache.cache, 0, glprogram->cache.size);
+        bench_uploads("hash lookup", scale, glprogram);
+        glprogram->uniform_loc = table;
+    }
+
+    gl4es_glDeleteProgram(program);
+    gl4es_glDeleteShader(vs);
+    gl4es_glDeleteShader(fs);
+}
@@ -0,0 +1,101 @@
+#!/bin/bash
+#
+# Replay the traces on the null GLES driver and check gl4es CPU cost against stored baselines
+# usage: perf.sh [-u] [-t threshold] [libdir]
+#  -u           (re)write the baselines in refs/perf/ instead of comparing
+#  -t threshold maximum allowed increase, in percent, before a metric is flagged (default 10)
+# Per-frame logs (see LIBGL_PERFLOG) are kept as <trace>.gles<N>.perf for inspection.
+# CPU time includes glretrace own overhead, so only compare baselines made on the same machine.
+# GLES calls, draws and uploaded bytes are deterministic and can be compared anywhere.
+
+UPDATE=0
+THRESHOLD=10
+while [ ! -z "$1" ]; do
+    case "$1" in
+        -u) UPDATE=1 ;;
+        -t) shift; THRESHOLD=$1 ;;
+        *) export LD_LIBRARY_PATH=$1:$LD_LIBRARY_PATH ;;
+    esac
+    shift
+done
+
+export LIBGL_NULLDRIVER=1
+export LIBGL_SILENTSTUB=1
+export LIBGL_NOBANNER=1
+export LIBGL_NOERROR=1
+
+# summary of a perf log: median and worst CPU time per frame, then mean of each counter per frame
+function summarize {
+    grep -v '^#' $1 | sort -n -k2 | awk '
+        { cpu[NR]=$2; calls+=$4; draws+=$5; verts+=$6; buf+=$7; tex+=$8 }
+        END {
+            if(NR==0) exit 1;
+            printf("frames %d\n", NR);
+            printf("cpu_us_median %d\n", cpu[int((NR+1)/2)]);
+            printf("cpu_us_max %d\n", cpu[NR]);
+            printf("gles_calls %.1f\n", calls/NR);
+            printf("draws %.1f\n", draws/NR);
+            printf("vertices %.1f\n", verts/NR);
+            printf("buffer_bytes %.1f\n", buf/NR);
+            printf("texture_bytes %.1f\n", tex/NR);
+        }'
+}
+
+# compare a summary to its baseline, print each metric and flag the ones over the threshold
+function compare_baseline {
+    awk -v thr=$THRESHOLD '
+        NR==FNR { base[$1]=$2; next }
+        {
+            b = base[$1]; flag = "";
+            # frame count and worst frame are informative only
+            if($1!="frames" && $1!="cpu_us_max" && ($2 > b*(1+thr/100.) + (b==0?0.5:0))) { flag = "  <== REGRESSION"; bad = 1 }
+            printf("  %-16s %14s (baseline %s)%s\n", $1, $2, b, flag);
+        }
+        END { exit bad }' $1 $2
+}
+
+export OK=1
+function perf_test {
+    local NAME=$1.gles$LIBGL_ES
+    echo " $NAME"
+    tar xf ../traces/$1.tgz
+    rm -f $NAME.perf
+    LIBGL_PERFLOG=$NAME.perf glretrace -b $1.trace >/dev/null
+    rm $1.trace
+    if ! summarize $NAME.perf > $NAME.summary; then
+        echo "  error, no frame replayed (segmentation fault?)"
+        export OK=0
+        return
+    fi
+    if [ "$UPDATE" = "1" ] || [ ! -e ../refs/perf/$NAME.txt ]; then
+        mkdir -p ../refs/perf
+        cp $NAME.summary ../refs/perf/$NAME.txt
+        echo "  baseline written"
+        sed 's/^/  /' $NAME.summary
+    elif ! compare_baseline ../refs/perf/$NAME.txt $NAME.summary; then
+        export OK=0
+    fi
+    rm $NAME.summary
+}
+
+TESTS=`dirname "$0"`
+
+pushd "$TESTS" >/dev/null
+
+export LIBGL_ES=1
+perf_test glxgears
+perf_test neverball
+
+export LIBGL_ES=2
+perf_test glxgears
+perf_test neverball
+perf_test glsl_lighting
+
+popd >/dev/null
+echo " ================= "
+if [ $OK = 0 ];then
+    echo "Performance regression (threshold $THRESHOLD%)"
+    exit 1
+fi
+echo "All done"
+exit 0